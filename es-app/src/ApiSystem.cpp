@@ -36,6 +36,7 @@
 #include <SDL.h>
 #include <Sound.h>
 #include "utils/ThreadPool.h"
+#include "utils/ProviderCache.h"
 
 #if WIN32
 #include <Windows.h>
@@ -51,6 +52,10 @@
 #include "RetroAchievements.h"
 #include "utils/ZipFile.h"
 
+// Seconds the results of enumeration scripts and folder scans are reused by the menus
+#define DEVICES_CACHE_TTL	10
+#define FOLDERS_CACHE_TTL	300
+
 ApiSystem::ApiSystem() { }
 
 ApiSystem* ApiSystem::instance = nullptr;
@@ -484,17 +489,17 @@ bool ApiSystem::removeBluetoothDevice(const std::string deviceName)
 
 std::vector<std::string> ApiSystem::getAvailableStorageDevices() 
 {
-	return executeEnumerationScript("batocera-config storage list");
+	return executeCachedEnumerationScript("batocera-config storage list", DEVICES_CACHE_TTL);
 }
 
 std::vector<std::string> ApiSystem::getVideoModes() 
 {
-	return executeEnumerationScript("batocera-resolution listModes");
+	return executeCachedEnumerationScript("batocera-resolution listModes", DEVICES_CACHE_TTL);
 }
 
 std::vector<std::string> ApiSystem::getAvailableBackupDevices() 
 {
-	return executeEnumerationScript("batocera-sync list");
+	return executeCachedEnumerationScript("batocera-sync list", DEVICES_CACHE_TTL);
 }
 
 std::vector<std::string> ApiSystem::getAvailableInstallDevices() 
@@ -650,12 +655,12 @@ std::vector<std::string> ApiSystem::getAvailableAudioOutputDevices()
 	return res;
 #endif
 
-	return executeEnumerationScript("batocera-audio list");
+	return executeCachedEnumerationScript("batocera-audio list", DEVICES_CACHE_TTL);
 }
 
 std::vector<std::string> ApiSystem::getAvailableVideoOutputDevices() 
 {
-	return executeEnumerationScript("batocera-config lsoutputs");
+	return executeCachedEnumerationScript("batocera-config lsoutputs", DEVICES_CACHE_TTL);
 }
 
 std::string ApiSystem::getCurrentAudioOutputDevice() 
@@ -1101,6 +1106,11 @@ std::vector<std::string> ApiSystem::executeEnumerationScript(const std::string c
 	return res;
 }
 
+std::vector<std::string> ApiSystem::executeCachedEnumerationScript(const std::string command, int ttlSeconds)
+{
+	return Utils::ProviderCache::get(command, ttlSeconds, [this, command] { return executeEnumerationScript(command); });
+}
+
 std::pair<std::string, int> ApiSystem::executeScript(const std::string command, const std::function<void(const std::string)>& func)
 {
 	LOG(LogInfo) << "ApiSystem::executeScript -> " << command;
@@ -1456,11 +1466,14 @@ std::vector<PacmanPackage> ApiSystem::getBatoceraStorePackages()
 
 std::pair<std::string, int> ApiSystem::installBatoceraStorePackage(std::string name, const std::function<void(const std::string)>& func)
 {
+	// Packages can bring shaders, sounds...
+	Utils::ProviderCache::invalidate();
 	return executeScript("batocera-store install \"" + name + "\"", func);
 }
 
 std::pair<std::string, int> ApiSystem::uninstallBatoceraStorePackage(std::string name, const std::function<void(const std::string)>& func)
 {
+	Utils::ProviderCache::invalidate();
 	return executeScript("batocera-store remove \"" + name + "\"", func);
 }
 
@@ -1476,6 +1489,11 @@ void ApiSystem::updateBatoceraStorePackageList()
 }
 
 std::vector<std::string> ApiSystem::getShaderList(const std::string systemName)
+{
+	return Utils::ProviderCache::get("ApiSystem::getShaderList", FOLDERS_CACHE_TTL, [] { return scanShaderList(); });
+}
+
+std::vector<std::string> ApiSystem::scanShaderList()
 {
 	Utils::FileSystem::FileSystemCacheActivator fsc;
 
@@ -1504,6 +1522,11 @@ std::vector<std::string> ApiSystem::getShaderList(const std::string systemName)
 
 
 std::vector<std::string> ApiSystem::getRetroachievementsSoundsList()
+{
+	return Utils::ProviderCache::get("ApiSystem::getRetroachievementsSoundsList", FOLDERS_CACHE_TTL, [] { return scanRetroachievementsSoundsList(); });
+}
+
+std::vector<std::string> ApiSystem::scanRetroachievementsSoundsList()
 {
 	Utils::FileSystem::FileSystemCacheActivator fsc;
 
@@ -1530,6 +1553,11 @@ std::vector<std::string> ApiSystem::getRetroachievementsSoundsList()
 }
 
 std::vector<std::string> ApiSystem::getTimezones()
+{
+	return Utils::ProviderCache::get("ApiSystem::getTimezones", FOLDERS_CACHE_TTL, [] { return scanTimezones(); });
+}
+
+std::vector<std::string> ApiSystem::scanTimezones()
 {
 	std::vector<std::string> ret;
 
@@ -229,6 +229,12 @@ protected:
 	virtual bool executeScript(const std::string command);  
 	virtual std::pair<std::string, int> executeScript(const std::string command, const std::function<void(const std::string)>& func);
 	virtual std::vector<std::string> executeEnumerationScript(const std::string command);
+	std::vector<std::string> executeCachedEnumerationScript(const std::string command, int ttlSeconds);
+
+	// Folder scans behind the cached lists
+	static std::vector<std::string> scanShaderList();
+	static std::vector<std::string> scanRetroachievementsSoundsList();
+	static std::vector<std::string> scanTimezones();
 	
 	void getBatoceraThemesImages(std::vector<BatoceraTheme>& items);
 	std::string getUpdateUrl();
@@ -0,0 +1,190 @@
+#include "Benchmark.h"
+
+#include "renderers/Renderer.h"
+#include "views/gamelist/MediaPrefetcher.h"
+#include "views/ViewController.h"
+#include "InputManager.h"
+#include "Log.h"
+#include "Settings.h"
+#include "SystemData.h"
+#include "Window.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+// Simulated frame duration : results don't depend on the speed of the machine running the benchmark
+#define BENCHMARK_FRAME_TIME 16
+
+Benchmark::Benchmark(Window* window) : mWindow(window)
+{
+}
+
+bool Benchmark::run(Window* window)
+{
+	if (SystemData::sSystemVector.size() == 0)
+	{
+		LOG(LogError) << "Benchmark::run\tNo systems to benchmark";
+		return false;
+	}
+
+	LOG(LogInfo) << "Benchmark::run\tStarting";
+
+	Benchmark benchmark(window);
+
+	benchmark.runSystemCarousel();
+
+	SystemData* system = nullptr;
+	for (auto sys : SystemData::sSystemVector)
+	{
+		if (!sys->isCollection())
+		{
+			system = sys;
+			break;
+		}
+	}
+
+	if (system != nullptr)
+	{
+		benchmark.runGamelist(system, "detailed");
+		benchmark.runGamelist(system, "grid");
+	}
+
+	benchmark.report();
+	return true;
+}
+
+void Benchmark::runSystemCarousel()
+{
+	ViewController::get()->goToSystemView(SystemData::sSystemVector.front(), true);
+
+	mPhases.push_back(Phase("system carousel"));
+	frames(60);
+
+	// Step through the systems, then scroll continuously
+	for (int i = 0; i < 10; i++)
+	{
+		press("right");
+		frames(30);
+	}
+
+	press("left", 180);
+	frames(60);
+}
+
+void Benchmark::runGamelist(SystemData* system, const std::string& viewStyle)
+{
+	if (!system->getTheme()->hasView(viewStyle))
+	{
+		LOG(LogInfo) << "Benchmark::runGamelist\tTheme has no " << viewStyle << " view, skipped";
+		return;
+	}
+
+	std::string previousStyle = Settings::getInstance()->getString("GamelistViewStyle");
+
+	Settings::getInstance()->setString("GamelistViewStyle", viewStyle);
+	ViewController::get()->removeGameListView(system);
+
+	mPhases.push_back(Phase(viewStyle + " gamelist"));
+
+	ViewController::get()->goToGameList(system, true);
+	frames(60);
+
+	for (int i = 0; i < 20; i++)
+	{
+		press("down");
+		frames(10);
+	}
+
+	press("down", 240);
+	frames(30);
+
+	press("up", 240);
+	frames(60);
+
+	Settings::getInstance()->setString("GamelistViewStyle", previousStyle);
+	ViewController::get()->removeGameListView(system);
+	ViewController::get()->goToSystemView(system, true);
+}
+
+void Benchmark::press(const std::string& button, int holdFrames)
+{
+	InputConfig* keyboard = InputManager::getInstance()->getInputConfigByDevice(DEVICE_KEYBOARD);
+
+	Input input;
+	if (keyboard == nullptr || !keyboard->getInputByName(button, &input))
+	{
+		LOG(LogWarning) << "Benchmark::press\tNo keyboard mapping for " << button;
+		frames(holdFrames);
+		return;
+	}
+
+	input.value = 1;
+	mWindow->input(keyboard, input);
+
+	frames(holdFrames);
+
+	input.value = 0;
+	mWindow->input(keyboard, input);
+}
+
+void Benchmark::frames(int count)
+{
+	Phase& phase = mPhases.back();
+
+	for (int i = 0; i < count; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		mWindow->update(BENCHMARK_FRAME_TIME);
+		mWindow->render();
+
+		auto end = std::chrono::steady_clock::now();
+
+		Renderer::swapBuffers();
+
+		const Renderer::FrameStats& stats = Renderer::getFrameStats();
+
+		phase.frameTimes.push_back(std::chrono::duration<float, std::milli>(end - start).count());
+		phase.draws += stats.draws;
+		phase.drawCalls += stats.drawCalls;
+		phase.textureBinds += stats.textureBinds;
+		phase.textureUploads += stats.textureUploads;
+		phase.textureUploadBytes += stats.textureUploadBytes;
+	}
+}
+
+void Benchmark::report()
+{
+	std::stringstream ss;
+	ss << std::fixed << std::setprecision(2);
+	ss << "Benchmark results (" << Renderer::getScreenWidth() << "x" << Renderer::getScreenHeight() << ", times in ms per frame)\n";
+
+	for (auto& phase : mPhases)
+	{
+		if (phase.frameTimes.size() == 0)
+			continue;
+
+		std::vector<float> times = phase.frameTimes;
+		std::sort(times.begin(), times.end());
+
+		float total = 0.0f;
+		for (auto time : times)
+			total += time;
+
+		const float frames = (float)times.size();
+
+		ss << "  " << phase.name << " : " << times.size() << " frames\n";
+		ss << "    cpu       avg " << (total / frames) << "  median " << times[times.size() / 2] << "  p95 " << times[(size_t)(times.size() * 0.95f)] << "  max " << times.back() << "\n";
+		ss << "    draws     " << (phase.draws / frames) << "  draw calls " << (phase.drawCalls / frames) << "  texture binds " << (phase.textureBinds / frames) << "\n";
+		ss << "    uploads   " << phase.textureUploads << " textures, " << (phase.textureUploadBytes / 1024) << " KB\n";
+	}
+
+	const MediaPrefetcher::Statistics& prefetch = MediaPrefetcher::getStatistics();
+	ss << "  artwork prefetch : " << prefetch.requested << " games, " << prefetch.hits << " hits, " << prefetch.late << " late, " << prefetch.misses << " misses, " << prefetch.cancelled << " cancelled\n";
+
+	LOG(LogInfo) << ss.str();
+	std::cout << ss.str();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef ES_APP_BENCHMARK_H
+#define ES_APP_BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+class Window;
+class SystemData;
+
+// Drives the views through a scripted navigation at a fixed frame rate, and reports the cost of each frame.
+// Run with --benchmark. With a HEADLESS build, it runs on machines without GPU or display
+class Benchmark
+{
+public:
+	static bool run(Window* window);
+
+private:
+	struct Phase
+	{
+		Phase(const std::string& _name) : name(_name) { }
+
+		std::string name;
+
+		std::vector<float> frameTimes; // ms of update + render
+		long long draws = 0;
+		long long drawCalls = 0;
+		long long textureBinds = 0;
+		long long textureUploads = 0;
+		long long textureUploadBytes = 0;
+	};
+
+	Benchmark(Window* window);
+
+	void runSystemCarousel();
+	void runGamelist(SystemData* system, const std::string& viewStyle);
+
+	void press(const std::string& button, int holdFrames = 1);
+	void frames(int count);
+
+	void report();
+
+	Window* mWindow;
+	std::vector<Phase> mPhases;
+};
+
+#endif // ES_APP_BENCHMARK_H
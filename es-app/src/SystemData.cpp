@@ -1706,12 +1706,17 @@ void SystemData::updateDisplayedGameCount()
 
 void SystemData::loadTheme()
 {
-	mTheme = std::make_shared<ThemeData>();
+	mTheme = createTheme();
+}
+
+std::shared_ptr<ThemeData> SystemData::createTheme(bool setDefault)
+{
+	std::shared_ptr<ThemeData> theme = std::make_shared<ThemeData>();
 
 	std::string path = getThemePath();
 
 	if(!Utils::FileSystem::exists(path)) // no theme available for this platform
-		return;
+		return theme;
 
 	try
 	{
@@ -1743,13 +1748,15 @@ void SystemData::loadTheme()
 		if (SystemConf::getInstance()->getBool("global.retroachievements"))
 			sysData.insert(std::pair<std::string, std::string>("cheevos.username", SystemConf::getInstance()->get("global.retroachievements.username")));
 
-		mTheme->loadFile(getThemeFolder(), sysData, path);
+		theme->loadFile(getThemeFolder(), sysData, path, true, setDefault);
 	}
 	catch(ThemeException& e)
 	{
 		LOG(LogError) << e.what();
-		mTheme = std::make_shared<ThemeData>(); // reset to empty
+		theme = std::make_shared<ThemeData>(); // reset to empty
 	}
+
+	return theme;
 }
 
 void SystemData::setSortId(const unsigned int sortId)
@@ -226,6 +226,9 @@ public:
 
 	// Load or re-load theme.
 	void loadTheme();
+	// Loads the theme without replacing the current one. Can run on a worker thread with setDefault = false
+	std::shared_ptr<ThemeData> createTheme(bool setDefault = true);
+	void setTheme(const std::shared_ptr<ThemeData>& theme) { mTheme = theme; }
 
 	FileFilterIndex* getIndex(bool createIndex);
 	void setIndex(FileFilterIndex* index) { mFilterIndex = index; }
@@ -638,6 +638,7 @@ void CarouselComponent::ensureLogo(IList<CarouselComponentData, FileData*>::Entr
 		ImageComponent* logo = new ImageComponent(mWindow, false, true);
 		logo->setMaxSize(mLogoSize * mLogoScale);
 		logo->setIsLinear(true);
+		logo->setMipmapped(true);
 		logo->applyTheme(mTheme, "gamecarousel", "gamecarouselLogo", ThemeFlags::COLOR | ThemeFlags::ALIGNMENT | ThemeFlags::VISIBLE); //  ThemeFlags::PATH | 
 		logo->setImage(marqueePath, false, MaxSizeInfo(mLogoSize * mLogoScale));
 
@@ -22,6 +22,7 @@ void RatingComponent::setValue(const std::string& value)
 
 	mValue = newValue;
 	updateVertices();
+	invalidateContent();
 }
 
 std::string RatingComponent::getValue() const
@@ -40,6 +41,7 @@ void RatingComponent::setOpacity(unsigned char opacity)
 
 	mOpacity = opacity;
 	updateColors();
+	invalidateContent();
 }
 
 void RatingComponent::setColorShift(unsigned int color)
@@ -49,6 +51,7 @@ void RatingComponent::setColorShift(unsigned int color)
 
 	mColorShift = color;
 	updateColors();
+	invalidateContent();
 }
 
 void RatingComponent::setUnfilledColor(unsigned int color)
@@ -58,6 +61,7 @@ void RatingComponent::setUnfilledColor(unsigned int color)
 
 	mUnfilledColor = color;
 	updateColors();
+	invalidateContent();
 }
 
 void RatingComponent::onSizeChanged()
@@ -179,6 +183,7 @@ bool RatingComponent::input(InputConfig* config, Input input)
 			mValue = 0.0f;
 
 		updateVertices();
+		invalidateContent();
 	}
 
 	return GuiComponent::input(config, input);
@@ -248,4 +253,5 @@ void RatingComponent::setHorizontalAlignment(Alignment align)
 
 	mHorizontalAlignment = align;
 	updateVertices();
+	invalidateContent();
 }
\ No newline at end of file
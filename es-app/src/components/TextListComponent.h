@@ -32,6 +32,7 @@ protected:
 	using IList<TextListData, T>::mSize;
 	using IList<TextListData, T>::mCursor;
 	using IList<TextListData, T>::Entry;
+	using IList<TextListData, T>::loadEntry;
 
 public:
 	using IList<TextListData, T>::size;
@@ -46,6 +47,7 @@ public:
 	void applyTheme(const std::shared_ptr<ThemeData>& theme, const std::string& view, const std::string& element, unsigned int properties) override;
 
 	void add(const std::string& name, const T& obj, unsigned int colorId);
+	void addUnloaded(const T& obj, unsigned int colorId); // name is given by the entry loader
 	
 	enum Alignment
 	{
@@ -91,6 +93,12 @@ protected:
 	virtual void onCursorChanged(const CursorState& state);
 
 private:
+	void releaseTextCaches(int start, int end);
+
+	// Entries which may own a text cache : caches are only kept around the visible entries
+	int mCachedStart;
+	int mCachedEnd;
+
 	int mMarqueeOffset;
 	int mMarqueeOffset2;
 	int mMarqueeTime;
@@ -135,6 +143,9 @@ TextListComponent<T>::TextListComponent(Window* window) :
 	mLastCursor = -1;
 	mLastCursorState = CursorState::CURSOR_STOPPED;
 
+	mCachedStart = 0;
+	mCachedEnd = 0;
+
 	mHorizontalMargin = 0;
 	mAlignment = ALIGN_CENTER;
 
@@ -188,6 +199,9 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 	if(listCutoff > size())
 		listCutoff = size();
 
+	// Text caches of the entries a page away are kept for scrolling, farther ones are released
+	releaseTextCaches(startEntry - screenCount, listCutoff + screenCount);
+
 	// draw selector bar
 	if(startEntry < listCutoff)
 	{
@@ -212,7 +226,7 @@ void TextListComponent<T>::render(const Transform4x4f& parentTrans)
 
 	for(int i = startEntry; i < listCutoff; i++)
 	{
-		typename IList<TextListData, T>::Entry& entry = mEntries.at((unsigned int)i);
+		typename IList<TextListData, T>::Entry& entry = loadEntry(i);
 
 		unsigned int color;
 		if(mCursor == i && mSelectedColor)
@@ -359,13 +373,16 @@ void TextListComponent<T>::update(int deltaTime)
 
 	listUpdate(deltaTime);
 
+	const int marqueeOffset = mMarqueeOffset;
+	const int marqueeOffset2 = mMarqueeOffset2;
+
 	if(!isScrolling() && size() > 0)
 	{
 		// always reset the marquee offsets
 		mMarqueeOffset  = 0;
 		mMarqueeOffset2 = 0;
 
-		std::string name = mEntries.at((unsigned int)mCursor).name;
+		std::string name = loadEntry(mCursor).name;
 		if (mUppercase)
 			name = Utils::String::toUpper(name);
 
@@ -396,6 +413,9 @@ void TextListComponent<T>::update(int deltaTime)
 		}
 	}
 
+	if (mMarqueeOffset != marqueeOffset || mMarqueeOffset2 != marqueeOffset2)
+		GuiComponent::invalidateContent();
+
 	GuiComponent::update(deltaTime);
 }
 
@@ -412,6 +432,34 @@ void TextListComponent<T>::add(const std::string& name, const T& obj, unsigned i
 	static_cast<IList< TextListData, T >*>(this)->add(entry);
 }
 
+template <typename T>
+void TextListComponent<T>::addUnloaded(const T& obj, unsigned int color)
+{
+	assert(color < COLOR_ID_COUNT);
+
+	typename IList<TextListData, T>::Entry entry;
+	entry.object = obj;
+	entry.data.colorId = color;
+	static_cast<IList< TextListData, T >*>(this)->addUnloaded(entry);
+}
+
+template <typename T>
+void TextListComponent<T>::releaseTextCaches(int start, int end)
+{
+	start = Math::max(0, start);
+	end = Math::min(end, size());
+
+	if (start == mCachedStart && end == mCachedEnd)
+		return;
+
+	for (int i = mCachedStart; i < mCachedEnd && i < size(); i++)
+		if (i < start || i >= end)
+			mEntries.at(i).data.textCache.reset();
+
+	mCachedStart = start;
+	mCachedEnd = end;
+}
+
 template <typename T>
 void TextListComponent<T>::onCursorChanged(const CursorState& state)
 {
@@ -206,6 +206,27 @@ if (!isKidUI) {
 }
 #ifdef _ENABLEEMUELEC
 /* < emuelec */
+// The shaders are listed by a script : it only runs when the list is opened
+static void populateShaderChoices(const std::shared_ptr<OptionListComponent<std::string>>& shaders_choices, const std::string& currentShader)
+{
+	std::string currentName = currentShader;
+	if (currentShader.empty() || currentShader == "auto")
+		currentName = _("AUTO");
+	else if (currentShader == "none")
+		currentName = _("NONE");
+
+	auto shaderList = shaders_choices.get();
+	shaders_choices->setLazyPopulate(currentName, currentShader.empty() ? "auto" : currentShader, [shaderList, currentShader]
+	{
+		shaderList->add(_("AUTO"), "auto", currentShader.empty() || currentShader == "auto");
+		shaderList->add(_("NONE"), "none", currentShader == "none");
+
+		std::string a;
+		for (std::stringstream ss(getCachedShOutput(R"(/usr/bin/emuelec-utils getshaders)", 300)); getline(ss, a, ','); )
+			shaderList->add(a, a, currentShader == a); // emuelec
+	});
+}
+
 void GuiMenu::openEmuELECSettings()
 {
 	auto s = new GuiSettings(mWindow, "EmuELEC Settings");
@@ -227,11 +248,21 @@ void GuiMenu::openEmuELECSettings()
 		videomode.push_back("576cvbs");
 		videomode.push_back("Custom");
 		videomode.push_back("-- AUTO-DETECTED RESOLUTIONS --");
-   for(std::stringstream ss(getShOutput(R"(/usr/bin/emuelec-utils resolutions)")); getline(ss, a, ','); ) {
-        videomode.push_back(a);
-	}
-		for (auto it = videomode.cbegin(); it != videomode.cend(); it++) {
-		emuelec_video_mode->add(*it, *it, SystemConf::getInstance()->get("ee_videomode") == *it); }
+
+		// The detected resolutions come from a script : it only runs when the list is opened
+		std::string currentVideoMode = SystemConf::getInstance()->get("ee_videomode");
+		auto videoModeList = emuelec_video_mode.get();
+		emuelec_video_mode->setLazyPopulate(currentVideoMode, currentVideoMode, [videoModeList, videomode, currentVideoMode]
+		{
+			std::vector<std::string> modes = videomode;
+
+			std::string a;
+			for (std::stringstream ss(getCachedShOutput(R"(/usr/bin/emuelec-utils resolutions)", 10)); getline(ss, a, ','); )
+				modes.push_back(a);
+
+			for (auto it = modes.cbegin(); it != modes.cend(); it++)
+				videoModeList->add(*it, *it, currentVideoMode == *it);
+		});
 		s->addWithLabel(_("VIDEO MODE"), emuelec_video_mode);
 	   	
 		s->addSaveFunc([this, emuelec_video_mode, window] {
@@ -1583,11 +1614,15 @@ void GuiMenu::openSystemSettings_batocera()
 	auto emuelec_timezones = std::make_shared<OptionListComponent<std::string> >(mWindow, _("TIMEZONE"), false);
 	std::string currentTimezone = SystemConf::getInstance()->get("system.timezone");
 	if (currentTimezone.empty())
-		currentTimezone = std::string(getShOutput(R"(/usr/bin/emuelec-utils current_timezone)"));
-	std::string a;
-	for(std::stringstream ss(getShOutput(R"(/usr/bin/emuelec-utils timezones)")); getline(ss, a, ','); ) {
-		emuelec_timezones->add(a, a, currentTimezone == a); // emuelec
-	}
+		currentTimezone = std::string(getCachedShOutput(R"(/usr/bin/emuelec-utils current_timezone)", 10));
+
+	auto timezoneList = emuelec_timezones.get();
+	emuelec_timezones->setLazyPopulate(currentTimezone, currentTimezone, [timezoneList, currentTimezone]
+	{
+		std::string a;
+		for (std::stringstream ss(getCachedShOutput(R"(/usr/bin/emuelec-utils timezones)", 3600)); getline(ss, a, ','); )
+			timezoneList->add(a, a, currentTimezone == a); // emuelec
+	});
 	s->addWithLabel(_("TIMEZONE"), emuelec_timezones);
 	s->addSaveFunc([emuelec_timezones] {
 		if (emuelec_timezones->changed()) {
@@ -2392,9 +2427,7 @@ void GuiMenu::openGamesSettings_batocera()
 			shaders_choices->add(_("NONE"), "none", currentShader == "none");
 
 #ifdef _ENABLEEMUELEC	
-	std::string a;
-	for(std::stringstream ss(getShOutput(R"(/usr/bin/emuelec-utils getshaders)")); getline(ss, a, ','); )
-		shaders_choices->add(a, a, currentShader == a); // emuelec
+			populateShaderChoices(shaders_choices, currentShader);
 #else
 			for (auto shader : installedShaders)
 				shaders_choices->add(_(Utils::String::toUpper(shader).c_str()), shader, currentShader == shader);
@@ -4393,10 +4426,7 @@ void GuiMenu::popSpecificConfigurationGui(Window* mWindow, std::string title, st
 			currentShader = std::string("auto");
 		}
 
-		shaders_choices->add(_("AUTO"), "auto", currentShader == "auto");
-		shaders_choices->add(_("NONE"), "none", currentShader == "none");
-		for(std::stringstream ss(getShOutput(R"(/usr/bin/emuelec-utils getshaders)")); getline(ss, a, ','); )
-		shaders_choices->add(a, a, currentShader == a); // emuelec
+		populateShaderChoices(shaders_choices, currentShader);
 		systemConfiguration->addWithLabel(_("SHADERS SET"), shaders_choices);
 		systemConfiguration->addSaveFunc([shaders_choices, configName] { SystemConf::getInstance()->set(configName + ".shaderset", shaders_choices->getSelected()); });
 	}
@@ -6,6 +6,8 @@
 #include "guis/GuiMsgBox.h"
 #include "utils/FileSystemUtil.h"
 #include "views/ViewController.h"
+#include "views/gamelist/FolderMosaic.h"
+#include "views/gamelist/GamePresentation.h"
 #include "CollectionSystemManager.h"
 #include "EmulationStation.h"
 #include "InputManager.h"
@@ -31,6 +33,8 @@
 #include "ThreadedHasher.h"
 #include <FreeImage.h>
 #include "ImageIO.h"
+#include "resources/Font.h"
+#include "Benchmark.h"
 #include "components/VideoVlcComponent.h"
 #include <csignal>
 #include "InputConfig.h"
@@ -44,6 +48,7 @@
 
 static std::string gPlayVideo;
 static int gPlayVideoDuration = 0;
+static bool gBenchmark = false;
 
 bool parseArgs(int argc, char* argv[])
 {
@@ -205,6 +210,11 @@ bool parseArgs(int argc, char* argv[])
 		{
 			Settings::getInstance()->setBool("ForceDisableFilters", true);
 		}
+		else if (strcmp(argv[i], "--benchmark") == 0)
+		{
+			gBenchmark = true;
+			Settings::getInstance()->setBool("SplashScreen", false);
+		}
 		else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0)
 		{
 #ifdef WIN32
@@ -233,6 +243,7 @@ bool parseArgs(int argc, char* argv[])
 				"--force-kid		Force the UI mode to be Kid\n"
 				"--force-kiosk		Force the UI mode to be Kiosk\n"
 				"--force-disable-filters		Force the UI to ignore applied filters in gamelist\n"
+				"--benchmark			run a scripted navigation, print frame timings and exit\n"
 				"--home [path]		Directory to use as home path\n"
 #ifdef _ENABLEEMUELEC
 				"--log-path [path]		Directory to use for log\n"
@@ -273,6 +284,7 @@ bool loadSystemConfigFile(Window* window, const char** errorString)
 	StopWatch stopWatch("loadSystemConfigFile :", LogDebug);
 
 	ImageIO::loadImageCache();
+	Font::loadGlyphCache();
 
 	if(!SystemData::loadConfig(window))
 	{
@@ -295,6 +307,50 @@ bool loadSystemConfigFile(Window* window, const char** errorString)
 	return true;
 }
 
+// Probes the size of every gamelist image in the background, so async texture loading never waits for file headers
+void buildImageCache()
+{
+	if (!Settings::getInstance()->getBool("AsyncImages"))
+		return;
+
+	std::vector<std::string> paths;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (system->isCollection())
+			continue;
+
+		for (auto file : system->getRootFolder()->getFilesRecursive(GAME))
+		{
+			for (auto id : { MetaDataId::Image, MetaDataId::Thumbnail, MetaDataId::Marquee })
+			{
+				auto value = file->getMetadata(id);
+				if (!value.empty())
+					paths.push_back(value);
+			}
+		}
+	}
+
+	ImageIO::buildImageCacheAsync(paths);
+}
+
+// Rasterizes the non latin characters of the game names in the background, so lists don't stutter when they first show them
+void prewarmFontGlyphs()
+{
+	std::vector<std::string> names;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (system->isCollection())
+			continue;
+
+		for (auto file : system->getRootFolder()->getFilesRecursive(GAME | FOLDER))
+			names.push_back(file->getName());
+	}
+
+	Font::prewarmGlyphs(names);
+}
+
 //called on exit, assuming we get far enough to have the log initialized
 void onExit()
 {
@@ -536,6 +592,12 @@ int main(int argc, char* argv[])
 		window.pushGui(new GuiMsgBox(&window, errorMsg, _("QUIT"), [] { quitES(); }));
 	}
 
+	if (errorMsg == NULL)
+	{
+		buildImageCache();
+		prewarmFontGlyphs();
+	}
+
 	SystemConf* systemConf = SystemConf::getInstance();
 
 #ifdef _ENABLE_KODI_
@@ -612,6 +674,14 @@ int main(int argc, char* argv[])
 
 	bool running = true;
 
+	if (gBenchmark)
+	{
+		if (errorMsg == NULL)
+			Benchmark::run(&window);
+
+		running = false;
+	}
+
 	while(running)
 	{
 #ifdef WIN32	
@@ -667,6 +737,15 @@ int main(int argc, char* argv[])
 			deltaTime = 1000;
 
 		TRYCATCH("Window.update" ,window.update(deltaTime))	
+
+		if (!window.isRenderNeeded())
+		{
+			// Nothing changed : the last frame stays on screen, wait for an event instead of redrawing it
+			SDL_WaitEventTimeout(NULL, 10);
+			Log::flush();
+			continue;
+		}
+
 		TRYCATCH("Window.render", window.render())
 
 #ifdef WIN32		
@@ -699,8 +778,13 @@ int main(int argc, char* argv[])
 		window.renderSplashScreen(_("SAVING METADATAS. PLEASE WAIT..."));
 
 	ImageIO::saveImageCache();
+	Font::saveGlyphCache();
 	MameNames::deinit();
 	ViewController::saveState();
+	ViewController::get()->cancelGameListModels();
+	ViewController::get()->cancelThemeReload();
+	FolderMosaic::stop();
+	GamePresentationCache::stop();
 	CollectionSystemManager::deinit();
 	SystemData::deleteSystems();
 
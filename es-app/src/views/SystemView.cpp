@@ -38,6 +38,11 @@ SystemView::SystemView(Window* window) : IList<SystemViewData, SystemData*>(wind
 	mDisable = false;		
 	mLastCursor = 0;
 	mExtrasFadeOldCursor = -1;
+	mCarouselSlotsDirty = true;
+	mCarouselSlotsCamOffset = 0;
+	mCarouselSlotsCursor = -1;
+	mCarouselSlotsBuffer = -1;
+	mCarouselSlotsEntries = 0;
 	
 	setSize((float)Renderer::getScreenWidth(), (float)Renderer::getScreenHeight());
 	populate();
@@ -67,6 +72,8 @@ void SystemView::clearEntries()
 	}
 
 	mEntries.clear();
+	mCarouselSlots.clear();
+	mCarouselSlotsDirty = true;
 }
 
 void SystemView::reloadTheme(SystemData* system)
@@ -74,12 +81,19 @@ void SystemView::reloadTheme(SystemData* system)
 	const std::shared_ptr<ThemeData>& theme = system->getTheme();
 	getViewElements(theme);
 
-	for (auto& e : mEntries)
+	for (int i = 0; i < (int)mEntries.size(); i++)
 	{
+		auto& e = mEntries.at(i);
 		if (e.object != system)
 			continue;
-		
-		if (e.data.logo != nullptr)
+
+		// A new theme may have another logo. The selected one keeps its storyboard state and is only restyled
+		if (i != mCursor)
+		{
+			e.data.logo.reset();
+			ensureLogo(e);
+		}
+		else if (e.data.logo != nullptr)
 		{
 			if (e.data.logo->isKindOf<TextComponent>())
 				e.data.logo->applyTheme(theme, "system", "logoText", ThemeFlags::FONT_PATH | ThemeFlags::FONT_SIZE | ThemeFlags::COLOR | ThemeFlags::FORCE_UPPERCASE | ThemeFlags::LINE_SPACING | ThemeFlags::TEXT);
@@ -87,7 +101,9 @@ void SystemView::reloadTheme(SystemData* system)
 				e.data.logo->applyTheme(theme, "system", "logo", ThemeFlags::COLOR | ThemeFlags::ALIGNMENT | ThemeFlags::VISIBLE);
 		}
 
-		loadExtras(system, e);
+		// Extras of systems away from the cursor are built with the new theme when they're needed
+		if (e.data.extrasLoaded)
+			loadExtras(system, e);
 	}
 }
 
@@ -145,9 +161,79 @@ void SystemView::loadExtras(SystemData* system, IList<SystemViewData, SystemData
 		return b->getZIndex() > a->getZIndex();
 	});
 
+	// Extras built while a window or the screensaver is over the view must follow their state
+	for (auto extra : e.data.backgroundExtras)
+	{
+		extra->topWindow(!mDisable);
+
+		if (mScreensaverActive)
+			extra->onScreenSaverActivate();
+	}
+
+	e.data.extrasLoaded = true;
+
 	SystemRandomPlaylist::resetCache();
 }
 
+void SystemView::ensureExtras(int cursor)
+{
+	if (cursor < 0 || cursor >= mEntries.size())
+		return;
+
+	auto& e = mEntries.at(cursor);
+	if (!e.data.extrasLoaded)
+		loadExtras(e.object, e);
+}
+
+// Deleting the extras releases their textures to the TextureDataManager
+void SystemView::releaseExtras(int cursor)
+{
+	if (cursor < 0 || cursor >= mEntries.size())
+		return;
+
+	auto& e = mEntries.at(cursor);
+	if (!e.data.extrasLoaded)
+		return;
+
+	setExtraRequired(cursor, false);
+
+	for (auto extra : e.data.backgroundExtras)
+		delete extra;
+
+	e.data.backgroundExtras.clear();
+	e.data.extrasLoaded = false;
+}
+
+// Builds the extras of the systems within SystemExtrasRadius of the cursor, and releases the others except keepCursor
+void SystemView::updateExtrasResidency(int keepCursor)
+{
+	int count = (int)mEntries.size();
+	if (count == 0)
+		return;
+
+	int radius = Settings::getInstance()->getInt("SystemExtrasRadius");
+	if (radius <= 0 || radius * 2 + 1 >= count)
+	{
+		for (int i = 0; i < count; i++)
+			ensureExtras(i);
+
+		return;
+	}
+
+	int cursor = Math::max(0, Math::min(count - 1, mCursor));
+
+	for (int i = 0; i < count; i++)
+	{
+		int distance = abs(i - cursor);
+		distance = Math::min(distance, count - distance);
+
+		if (distance <= radius)
+			ensureExtras(i);
+		else if (i != keepCursor)
+			releaseExtras(i);
+	}
+}
+
 void SystemView::ensureLogo(IList<SystemViewData, SystemData*>::Entry& entry)
 {
 	if (entry.data.logo != nullptr)
@@ -274,12 +360,14 @@ void SystemView::populate()
 			e.object = *it;
 
 			ensureLogo(e);
-			loadExtras(*it, e);
-
 			add(e);
 		}
 	}
 
+	updateExtrasResidency();
+
+	mCarouselSlotsDirty = true;
+
 	TextureLoader::paused = false;
 
 	if (mEntries.size() == 0)
@@ -673,6 +761,14 @@ void SystemView::update(int deltaTime)
 	
 	GuiComponent::update(deltaTime);
 
+	// Systems crossed by a long slide are outside the resident window : their extras are built here, before rendering
+	int count = (int)mEntries.size();
+	if (count > 0)
+	{
+		for (int i = (int)mExtrasCamOffset; i <= (int)(mExtrasCamOffset + 0.99999f); i++)
+			ensureExtras(((i % count) + count) % count);
+	}
+
 	if (mYButton.isLongPressed(deltaTime))
 	{
 		bool netPlay = SystemData::isNetplayActivated() && SystemConf::getInstance()->getBool("global.netplay");
@@ -756,6 +852,9 @@ void SystemView::onCursorChanged(const CursorState& /*state*/)
 
 	ensureLogo(mEntries.at(mCursor));
 
+	// The previous system stays loaded for the transition
+	updateExtrasResidency(mLastCursor);
+
 	// update help style
 	updateHelpPrompts();
 
@@ -971,6 +1070,8 @@ void SystemView::onCursorChanged(const CursorState& /*state*/)
 			if (i != mCursor)
 				activateExtras(i, false);
 
+		updateExtrasResidency();
+
 	}, false, 0);
 }
 
@@ -1066,6 +1167,8 @@ void  SystemView::getViewElements(const std::shared_ptr<ThemeData>& theme)
 {
 	LOG(LogDebug) << "SystemView::getViewElements()";
 
+	mCarouselSlotsDirty = true;
+
 	getDefaultElements();
 
 	if (!theme->hasView("system"))
@@ -1112,20 +1215,25 @@ void  SystemView::getViewElements(const std::shared_ptr<ThemeData>& theme)
 }
 
 //  Render system carousel
-void SystemView::renderCarousel(const Transform4x4f& trans)
+void SystemView::updateCarouselSlots()
 {
-	// background box behind logos
-	Transform4x4f carouselTrans = trans;
-	carouselTrans.translate(Vector3f(mCarousel.pos.x(), mCarousel.pos.y(), 0.0));
-	carouselTrans.translate(Vector3f(mCarousel.origin.x() * mCarousel.size.x() * -1, mCarousel.origin.y() * mCarousel.size.y() * -1, 0.0f));
+	// Adding texture loading buffers depending on scrolling speed and status
+	int bufferIndex = Math::max(0, Math::min(2, getScrollingVelocity() + 1));
 
-	Vector2f clipPos(carouselTrans.translation().x(), carouselTrans.translation().y());
-	Renderer::pushClipRect(Vector2i((int)clipPos.x(), (int)clipPos.y()), Vector2i((int)mCarousel.size.x(), (int)mCarousel.size.y()));
+	if (!mCarouselSlotsDirty && mCarouselSlotsCamOffset == mCamOffset && mCarouselSlotsCursor == mCursor && mCarouselSlotsBuffer == bufferIndex && mCarouselSlotsEntries == (int)mEntries.size())
+		return;
 
-	Renderer::setMatrix(carouselTrans);
-	Renderer::drawRect(0.0f, 0.0f, mCarousel.size.x(), mCarousel.size.y(), mCarousel.color, mCarousel.colorEnd, mCarousel.colorGradientHorizontal);
+	mCarouselSlotsDirty = false;
+	mCarouselSlotsCamOffset = mCamOffset;
+	mCarouselSlotsCursor = mCursor;
+	mCarouselSlotsBuffer = bufferIndex;
+	mCarouselSlotsEntries = (int)mEntries.size();
+
+	mCarouselSlots.clear();
+
+	if (mEntries.size() == 0)
+		return;
 
-	// draw logos
 	Vector2f logoSpacing(0.0, 0.0); // NB: logoSpacing will include the size of the logo itself as well!
 	float xOff = 0.0;
 	float yOff = 0.0;
@@ -1184,8 +1292,6 @@ void SystemView::renderCarousel(const Transform4x4f& trans)
 	int center = (int)(mCamOffset);
 	int logoCount = Math::min(mCarousel.maxLogoCount, (int)mEntries.size());
 
-	// Adding texture loading buffers depending on scrolling speed and status
-	int bufferIndex = Math::max(0, Math::min(2, getScrollingVelocity() + 1));
 	int bufferLeft = logoBuffersLeft[bufferIndex];
 	int bufferRight = logoBuffersRight[bufferIndex];
 
@@ -1195,59 +1301,85 @@ void SystemView::renderCarousel(const Transform4x4f& trans)
 		bufferRight = 0;
 	}
 
-	auto renderLogo = [this, carouselTrans, logoSpacing, xOff, yOff](int i)
+	int opref = (Math::clamp(mCarousel.minLogoOpacity, 0, 1) * 255);
+
+	auto makeSlot = [this, logoSpacing, xOff, yOff, opref](int i, int index)
+	{
+		CarouselSlot slot;
+		slot.index = index;
+		slot.offset = Vector3f(i * logoSpacing[0] + xOff, i * logoSpacing[1] + yOff, 0);
+		slot.distance = i - mCamOffset;
+
+		float scale = 1.0f + ((mCarousel.logoScale - 1.0f) * (1.0f - fabs(slot.distance)));
+		scale = Math::min(mCarousel.logoScale, Math::max(1.0f, scale));
+		slot.scale = scale / mCarousel.logoScale;
+
+		int opacity = (int)Math::round(opref + ((0xFF - opref) * (1.0f - fabs(slot.distance))));
+		slot.opacity = (unsigned char)Math::max((int)opref, opacity);
+
+		ensureLogo(mEntries.at(index));
+		return slot;
+	};
+
+	// The selected logo is drawn last, over its neighbours
+	std::vector<CarouselSlot> activeSlots;
+
+	for (int i = center - logoCount / 2 + bufferLeft; i <= center + logoCount / 2 + bufferRight; i++)
 	{
 		int index = i % (int)mEntries.size();
 		if (index < 0)
 			index += (int)mEntries.size();
+	
+		if (index == mCursor)
+			activeSlots.push_back(makeSlot(i, index));
+		else
+			mCarouselSlots.push_back(makeSlot(i, index));
+	}
 
-		Transform4x4f logoTrans = carouselTrans;
-		logoTrans.translate(Vector3f(i * logoSpacing[0] + xOff, i * logoSpacing[1] + yOff, 0));
+	for (auto& slot : activeSlots)
+		mCarouselSlots.push_back(slot);
+}
+
+void SystemView::renderCarousel(const Transform4x4f& trans)
+{
+	// background box behind logos
+	Transform4x4f carouselTrans = trans;
+	carouselTrans.translate(Vector3f(mCarousel.pos.x(), mCarousel.pos.y(), 0.0));
+	carouselTrans.translate(Vector3f(mCarousel.origin.x() * mCarousel.size.x() * -1, mCarousel.origin.y() * mCarousel.size.y() * -1, 0.0f));
 
-		float distance = i - mCamOffset;
+	Vector2f clipPos(carouselTrans.translation().x(), carouselTrans.translation().y());
+	Renderer::pushClipRect(Vector2i((int)clipPos.x(), (int)clipPos.y()), Vector2i((int)mCarousel.size.x(), (int)mCarousel.size.y()));
 
-		float scale = 1.0f + ((mCarousel.logoScale - 1.0f) * (1.0f - fabs(distance)));
-		scale = Math::min(mCarousel.logoScale, Math::max(1.0f, scale));
-		scale /= mCarousel.logoScale;
+	Renderer::setMatrix(carouselTrans);
+	Renderer::drawRect(0.0f, 0.0f, mCarousel.size.x(), mCarousel.size.y(), mCarousel.color, mCarousel.colorEnd, mCarousel.colorGradientHorizontal);
 
-		int opref = (Math::clamp(mCarousel.minLogoOpacity, 0, 1) * 255);
+	updateCarouselSlots();
 
-		int opacity = (int)Math::round(opref + ((0xFF - opref) * (1.0f - fabs(distance))));
-		opacity = Math::max((int)opref, opacity);
+	// draw logos : consecutive logos sharing an atlas page are merged in one draw call by the renderer
+	bool wheel = (mCarousel.type == VERTICAL_WHEEL || mCarousel.type == HORIZONTAL_WHEEL);
 
-		ensureLogo(mEntries.at(index));
+	for (auto& slot : mCarouselSlots)
+	{
+		auto& entry = mEntries.at(slot.index);
+		ensureLogo(entry);
 
-		const std::shared_ptr<GuiComponent> &comp = mEntries.at(index).data.logo;
-		if (mCarousel.type == VERTICAL_WHEEL || mCarousel.type == HORIZONTAL_WHEEL) {
-			comp->setRotationDegrees(mCarousel.logoRotation * distance);
+		const std::shared_ptr<GuiComponent> &comp = entry.data.logo;
+		if (wheel) 
+		{
+			comp->setRotationDegrees(mCarousel.logoRotation * slot.distance);
 			comp->setRotationOrigin(mCarousel.logoRotationOrigin);
 		}
 		
 		if (!mCarousel.anyLogoHasOpacityStoryboard)
-			comp->setOpacity((unsigned char)opacity);
+			comp->setOpacity(slot.opacity);
 
 		if (!mCarousel.anyLogoHasScaleStoryboard)
-			comp->setScale(scale);
-		
-		comp->render(logoTrans);
-	};
+			comp->setScale(slot.scale);
 
-
-	std::vector<int> activePositions;
-	for (int i = center - logoCount / 2 + bufferLeft; i <= center + logoCount / 2 + bufferRight; i++)
-	{
-		int index = i % (int)mEntries.size();
-		if (index < 0)
-			index += (int)mEntries.size();
-	
-		if (index == mCursor)
-			activePositions.push_back(i);
-		else
-			renderLogo(i);
+		Transform4x4f logoTrans = carouselTrans;
+		logoTrans.translate(slot.offset);
+		comp->render(logoTrans);
 	}
-	
-	for (auto activePos : activePositions)
-		renderLogo(activePos);
 
 	Renderer::popClipRect();
 }
@@ -1383,7 +1515,7 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 			if (extra->getZIndex() < lower || extra->getZIndex() >= upper)
 				continue;
 			
-			if (extra->isStaticExtra())
+			if (extra->isStaticExtra() || !extra->isVisible())
 				continue;
 
 			std::string value = extra->getValue();
@@ -1392,23 +1524,23 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 				if (allPaths.find(value) == allPaths.cend())
 				{					
 					if (extra->getTag() == "background" || extra->getTag().find("bg-") == 0 || extra->getTag().find("bg_") == 0)
-						extra->render(trans);
+						extra->renderCached(trans);
 					else
 					{
 						auto opa = extra->getOpacity();
 						extra->setOpacity(mExtrasFadeOpacity * opa);
-						extra->render(trans);
+						extra->renderCached(trans);
 						extra->setOpacity(opa);
 					}
 				}
 				else if (extra->isKindOf<ImageComponent>() && ((ImageComponent*)extra)->isTiled() && extra->getPosition() == Vector3f::Zero() && extra->getSize() == Vector2f(Renderer::getScreenWidth(), Renderer::getScreenHeight()))					
-					extra->render(trans);
+					extra->renderCached(trans);
 			}
 			else if (extra->isKindOf<TextComponent>() && allValues.find(value) == allValues.cend())
 			{
 				auto opa = extra->getOpacity();
 				extra->setOpacity(mExtrasFadeOpacity * opa);
-				extra->render(trans);
+				extra->renderCached(trans);
 				extra->setOpacity(opa);
 				//extra->render(trans);
 			}				
@@ -1463,6 +1595,10 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 			if (extra->getZIndex() < lower || extra->getZIndex() >= upper)
 				continue;
 
+			// Hidden extras are skipped before any value lookup or transform
+			if (!extra->isVisible())
+				continue;
+
 			// ExtrasFadeOpacity : Apply opacity only on elements that are not common with the original view
 			if (mExtrasFadeOpacity && !extra->isStaticExtra())
 			{			
@@ -1498,7 +1634,7 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 					{							
 						auto opa = extra->getOpacity();
 						extra->setOpacity((1.0f - mExtrasFadeOpacity) * opa);						
-						extra->render(extra->isStaticExtra() ? trans : xt);
+						extra->renderCached(extra->isStaticExtra() ? trans : xt);
 						extra->setOpacity(opa);
 						continue;
 					}								
@@ -1506,7 +1642,7 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 					{
 						auto opa = extra->getOpacity();
 						extra->setOpacity((1.0f - mExtrasFadeOpacity) * opa);
-						extra->render(extra->isStaticExtra() ? trans : extrasTrans);
+						extra->renderCached(extra->isStaticExtra() ? trans : extrasTrans);
 						extra->setOpacity(opa);
 						continue;
 					}
@@ -1515,7 +1651,7 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 				{
 					auto opa = extra->getOpacity();
 					extra->setOpacity((1.0f - mExtrasFadeOpacity) * opa);
-					extra->render(extra->isStaticExtra() ? trans : extrasTrans);
+					extra->renderCached(extra->isStaticExtra() ? trans : extrasTrans);
 					extra->setOpacity(opa);
 					continue;
 				}
@@ -1548,13 +1684,13 @@ void SystemView::renderExtras(const Transform4x4f& trans, float lower, float upp
 					popClip = true;
 				}
 			
-				extra->render(trans);
+				extra->renderCached(trans);
 				
 				if (popClip)
 					Renderer::popClipRect();	
 			}
 			else
-				extra->render(extrasTrans);
+				extra->renderCached(extrasTrans);
 		}
 
 		Renderer::popClipRect();		
@@ -24,8 +24,11 @@ enum CarouselType : unsigned int
 
 struct SystemViewData
 {
+	SystemViewData() : extrasLoaded(false) { }
+
 	std::shared_ptr<GuiComponent> logo;
 	std::vector<GuiComponent*> backgroundExtras;
+	bool extrasLoaded; // extras are only built for the systems near the cursor
 };
 
 struct SystemViewCarousel
@@ -87,6 +90,9 @@ protected:
 private:
 	void	 ensureLogo(IList<SystemViewData, SystemData*>::Entry& entry);
 	void	 loadExtras(SystemData* system, IList<SystemViewData, SystemData*>::Entry& e);
+	void	 ensureExtras(int cursor);
+	void	 releaseExtras(int cursor);
+	void	 updateExtrasResidency(int keepCursor = -1);
 	void	 updateExtraTextBinding();
 	void	 showQuickSearch();
 
@@ -109,6 +115,7 @@ private:
 	void getDefaultElements(void);
 	void getCarouselFromTheme(const ThemeData::ThemeElement* elem);
 
+	void updateCarouselSlots();
 	void renderCarousel(const Transform4x4f& parentTrans);
 	void renderExtras(const Transform4x4f& parentTrans, float lower, float upper);
 	void renderInfoBar(const Transform4x4f& trans);
@@ -118,6 +125,23 @@ private:
 	std::vector<ImageComponent*>		mStaticBackgrounds;
 	std::vector<VideoVlcComponent*>		mStaticVideoBackgrounds;
 
+	// Carousel layout of the visible logos, in drawing order. Only computed again when the camera, the cursor, or the layout change
+	struct CarouselSlot
+	{
+		int			index;		// entry
+		Vector3f	offset;		// in the carousel
+		float		distance;	// from the camera, in list index
+		float		scale;
+		unsigned char opacity;
+	};
+
+	std::vector<CarouselSlot>	mCarouselSlots;
+	bool						mCarouselSlotsDirty;
+	float						mCarouselSlotsCamOffset;
+	int							mCarouselSlotsCursor;
+	int							mCarouselSlotsBuffer;
+	int							mCarouselSlotsEntries;
+
 	// unit is list index
 	float mCamOffset;
 	float mExtrasCamOffset;
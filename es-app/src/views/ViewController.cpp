@@ -27,6 +27,10 @@
 #include "guis/GuiMsgBox.h"
 #include "utils/ThreadPool.h"
 #include <SDL_timer.h>
+#include <algorithm>
+
+// Time given each frame to swap in the themes of a progressive reload, in ms
+#define THEME_SWAP_FRAME_BUDGET	8
 
 #ifdef _ENABLEEMUELEC
 #include "ApiSystem.h"
@@ -70,7 +74,8 @@ void ViewController::saveState()
 }
 
 ViewController::ViewController(Window* window)
-	: GuiComponent(window), mCurrentView(nullptr), mCamera(Transform4x4f::Identity()), mFadeOpacity(0), mLockInput(false)
+	: GuiComponent(window), mCurrentView(nullptr), mCamera(Transform4x4f::Identity()), mFadeOpacity(0), mLockInput(false), mModelThread(nullptr), mModelThreadCancel(false), mPendingModels(0),
+	  mThemeThread(nullptr), mThemeThreadCancel(false), mPendingThemes(0)
 {
 	mSystemListView = nullptr;
 	mState.viewing = NOTHING;	
@@ -79,6 +84,9 @@ ViewController::ViewController(Window* window)
 
 ViewController::~ViewController()
 {	
+	cancelGameListModels();
+	cancelThemeReload();
+
 	ISimpleGameListView* simpleView = dynamic_cast<ISimpleGameListView*>(mCurrentView.get());
 	if (simpleView != nullptr)
 		simpleView->closePopupContext();
@@ -408,6 +416,9 @@ void ViewController::playViewTransition(bool forceImmediate)
 
 void ViewController::onFileChanged(FileData* file, FileChangeType change)
 {
+	// Models that are ready may not contain the change
+	cancelGameListModels();
+
 	std::string key = file->getFullPath();
 	auto sourceSystem = file->getSourceFileData()->getSystem();
 
@@ -432,6 +443,9 @@ void ViewController::onFileChanged(FileData* file, FileChangeType change)
 
 bool ViewController::doLaunchGame(FileData* game, LaunchGameOptions options)
 {
+	// Launching updates the metadata of the game
+	cancelGameListModels();
+
 	if (mCurrentView) mCurrentView->onHide();
 
 	if (game->launchGame(mWindow, options))
@@ -619,6 +633,8 @@ void ViewController::launch(FileData* game, LaunchGameOptions options, Vector3f
 
 void ViewController::removeGameListView(SystemData* system)
 {
+	cancelGameListModels();
+
 	//if we already made one, return that one
 	auto exists = mGameListViews.find(system);
 	if(exists != mGameListViews.cend())
@@ -628,25 +644,9 @@ void ViewController::removeGameListView(SystemData* system)
 	}
 }
 
-std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* system, bool loadIfnull, const std::function<void()>& createAsPopupAndSetExitFunction)
+// Everything read from the settings and the theme : on the UI thread, where they are changed
+void ViewController::prepareGameListModel(SystemData* system, GameListModel& model)
 {
-	if (createAsPopupAndSetExitFunction == nullptr)
-	{
-		//if we already made one, return that one
-		auto exists = mGameListViews.find(system);
-		if (exists != mGameListViews.cend())
-			return exists->second;
-
-		if (!loadIfnull)
-			return nullptr;
-
-		system->setUIModeFilters();
-		system->updateDisplayedGameCount();
-	}
-
-	//if we didn't, make it, remember it, and return it
-	std::shared_ptr<IGameListView> view;
-
 	bool themeHasGamecarouselView = system->getTheme()->hasView("gamecarousel");
 	bool themeHasVideoView = system->getTheme()->hasView("video");
 	bool themeHasGridView = system->getTheme()->hasView("grid");
@@ -709,48 +709,125 @@ std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* syste
 	else if (themeHasGamecarouselView && viewPreference.compare("gamecarousel") == 0)
 		selectedViewType = GAMECAROUSEL;
 
-	if (!forceView && (selectedViewType == AUTOMATIC || allowDetailedDowngrade))
+	model.viewType = selectedViewType;
+	model.customThemeName = customThemeName;
+	model.gridSizeOverride = gridSizeOverride;
+	model.allowDetailedDowngrade = allowDetailedDowngrade;
+	model.detectViewType = !forceView && (selectedViewType == AUTOMATIC || allowDetailedDowngrade);
+
+	model.themeDefaultView = system->getTheme()->getDefaultView();
+	model.themeHasVideoView = themeHasVideoView;
+	model.localArt = Settings::getInstance()->getBool("LocalArt");
+}
+
+// Only reads the games of the system : it can run on a worker thread, as long as the UI doesn't use them meanwhile
+void ViewController::fillGameListModel(SystemData* system, GameListModel& model, bool onUiThread)
+{
+	// With local art, looking for medias writes the paths it finds in the metadata : leave it to the UI thread
+	if (model.detectViewType && (onUiThread || !model.localArt))
 	{
-		selectedViewType = BASIC;
+		model.viewType = detectGameListViewType(system, model);
+		model.detectViewType = false;
+	}
+
+	model.entries = system->getRootFolder()->getChildrenListToDisplay();
+}
 
-		if (system->getTheme()->getDefaultView() != "basic")
+ViewController::GameListViewType ViewController::detectGameListViewType(SystemData* system, const GameListModel& model)
+{
+	if (model.themeDefaultView == "basic")
+		return BASIC;
+
+	bool themeHasVideoView = model.themeHasVideoView;
+	bool allowDetailedDowngrade = model.allowDetailedDowngrade;
+
+	GameListViewType selectedViewType = BASIC;
+
+	std::vector<FileData*> files = system->getRootFolder()->getFilesRecursive(GAME | FOLDER);
+	for (auto it = files.cbegin(); it != files.cend(); it++)
+	{
+		if (!allowDetailedDowngrade && themeHasVideoView && !(*it)->getVideoPath().empty())
 		{
-			std::vector<FileData*> files = system->getRootFolder()->getFilesRecursive(GAME | FOLDER);
-			for (auto it = files.cbegin(); it != files.cend(); it++)
-			{
-				if (!allowDetailedDowngrade && themeHasVideoView && !(*it)->getVideoPath().empty())
-				{
-					selectedViewType = VIDEO;
-					break;
-				}
-				else if (!(*it)->getThumbnailPath().empty())
-				{
-					selectedViewType = DETAILED;
+			selectedViewType = VIDEO;
+			break;
+		}
+		else if (!(*it)->getThumbnailPath().empty())
+		{
+			selectedViewType = DETAILED;
 
-					if (!themeHasVideoView)
-						break;
-				}
-			}
+			if (!themeHasVideoView)
+				break;
 		}
 	}
 
+	return selectedViewType;
+}
+
+std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* system, bool loadIfnull, const std::function<void()>& createAsPopupAndSetExitFunction)
+{
+	if (createAsPopupAndSetExitFunction == nullptr)
+	{
+		//if we already made one, return that one
+		auto exists = mGameListViews.find(system);
+		if (exists != mGameListViews.cend())
+			return exists->second;
+
+		if (!loadIfnull)
+			return nullptr;
+
+		system->setUIModeFilters();
+		system->updateDisplayedGameCount();
+	}
+
+	std::shared_ptr<GameListModel> model;
+
+	if (createAsPopupAndSetExitFunction == nullptr)
+	{
+		std::unique_lock<std::mutex> lock(mModelLock);
+
+		auto prepared = mGameListModels.find(system);
+		if (prepared != mGameListModels.cend())
+		{
+			model = prepared->second;
+			mGameListModels.erase(prepared);
+		}
+	}
+
+	if (model == nullptr)
+	{
+		// The worker shares lazily initialized data of the games : it must be stopped before building here
+		cancelGameListModels();
+
+		model = std::make_shared<GameListModel>();
+		prepareGameListModel(system, *model);
+		fillGameListModel(system, *model, true);
+	}
+	else if (model->detectViewType)
+		model->viewType = detectGameListViewType(system, *model);
+
+	//if we didn't, make it, remember it, and return it
+	std::shared_ptr<IGameListView> view;
+
+	GameListViewType selectedViewType = model->viewType;
+	const std::string& customThemeName = model->customThemeName;
+
 	// Create the view
 	switch (selectedViewType)
 	{
 		case VIDEO:
-			view = std::shared_ptr<IGameListView>(new VideoGameListView(mWindow, system->getRootFolder()));
+			view = std::shared_ptr<IGameListView>(new VideoGameListView(mWindow, system->getRootFolder(), &model->entries));
 			break;
 		case DETAILED:
-			view = std::shared_ptr<IGameListView>(new DetailedGameListView(mWindow, system->getRootFolder()));
+			view = std::shared_ptr<IGameListView>(new DetailedGameListView(mWindow, system->getRootFolder(), &model->entries));
 			break;
 		case GRID:
-			view = std::shared_ptr<IGameListView>(new GridGameListView(mWindow, system->getRootFolder(), system->getTheme(), customThemeName, gridSizeOverride));
+			view = std::shared_ptr<IGameListView>(new GridGameListView(mWindow, system->getRootFolder(), system->getTheme(), customThemeName, model->gridSizeOverride, &model->entries));
 			break;
 		case GAMECAROUSEL:
-			view = std::shared_ptr<IGameListView>(new CarouselGameListView(mWindow, system->getRootFolder()));
+			view = std::shared_ptr<IGameListView>(new CarouselGameListView(mWindow, system->getRootFolder(), &model->entries));
 			break;
 		default:
-			view = std::shared_ptr<IGameListView>(new BasicGameListView(mWindow, system->getRootFolder()));
+			view = std::shared_ptr<IGameListView>(new BasicGameListView(mWindow, system->getRootFolder(), &model->entries));
 			break;
 	}
 
@@ -787,11 +864,106 @@ std::shared_ptr<IGameListView> ViewController::getGameListView(SystemData* syste
 
 		addChild(view.get());
 		mGameListViews[system] = view;
+
+		if (model->cursor != nullptr)
+			view->setCursor(model->cursor);
 	}
 
 	return view;
 }
 
+void ViewController::startGameListModels(const std::vector<std::pair<SystemData*, FileData*>>& systems)
+{
+	cancelGameListModels();
+
+	if (systems.size() == 0)
+		return;
+
+	std::vector<std::pair<SystemData*, std::shared_ptr<GameListModel>>> models;
+
+	for (auto system : systems)
+	{
+		// Games of collections belong to other systems too : their views are built on the UI thread when needed
+		if (system.first->isCollection())
+			continue;
+
+		std::shared_ptr<GameListModel> model = std::make_shared<GameListModel>();
+		model->cursor = system.second;
+		prepareGameListModel(system.first, *model);
+		models.push_back(std::pair<SystemData*, std::shared_ptr<GameListModel>>(system.first, model));
+	}
+
+	if (models.size() == 0)
+		return;
+
+	mModelThreadCancel = false;
+	mPendingModels = (int)models.size();
+
+	// A single worker, in the order of the systems. It only touches the games of the system it's building :
+	// it is cancelled before the UI uses them, see getGameListView, reloadGameListView and update
+	mModelThread = new std::thread([this, models]
+	{
+		for (auto system : models)
+		{
+			if (mModelThreadCancel)
+				break;
+
+			fillGameListModel(system.first, *system.second, false);
+
+			std::unique_lock<std::mutex> lock(mModelLock);
+			mGameListModels[system.first] = system.second;
+			mPendingModels--;
+		}
+	});
+}
+
+void ViewController::cancelGameListModels()
+{
+	if (mModelThread != nullptr)
+	{
+		mModelThreadCancel = true;
+		mModelThread->join();
+
+		delete mModelThread;
+		mModelThread = nullptr;
+	}
+
+	std::unique_lock<std::mutex> lock(mModelLock);
+	mGameListModels.clear();
+}
+
+// Creates the view of a model that is ready : one per frame, so the UI stays responsive
+void ViewController::attachGameListModel()
+{
+	if (mModelThread == nullptr)
+		return;
+
+	SystemData* system = nullptr;
+	bool done = false;
+
+	{
+		std::unique_lock<std::mutex> lock(mModelLock);
+
+		while (mGameListModels.size() > 0 && system == nullptr)
+		{
+			auto it = mGameListModels.begin();
+
+			// Views that were needed before their model was ready have been built on the UI thread
+			if (mGameListViews.find(it->first) != mGameListViews.cend())
+				mGameListModels.erase(it);
+			else
+				system = it->first;
+		}
+
+		done = (system == nullptr && mPendingModels == 0);
+	}
+
+	if (system != nullptr)
+		getGameListView(system);
+	else if (done)
+		cancelGameListModels();
+}
+
 std::shared_ptr<SystemView> ViewController::getSystemListView()
 {
 	//if we already made one, return that one
@@ -886,11 +1058,18 @@ bool ViewController::input(InputConfig* config, Input input)
 
 void ViewController::update(int deltaTime)
 {
+	// Menus and popups change settings and metadata : the games can't be shared with the worker anymore
+	if (mModelThread != nullptr && mWindow->peekGui() != this)
+		cancelGameListModels();
+
 	if (mCurrentView)
 		mCurrentView->update(deltaTime);
 
 	updateSelf(deltaTime);
 
+	swapLoadedThemes();
+	attachGameListModel();
+
 	if (mDeferPlayViewTransitionTo != nullptr)
 	{
 		auto destView = mDeferPlayViewTransitionTo;
@@ -969,15 +1148,33 @@ void ViewController::preload()
 	mWindow->renderSplashScreen(_("Preloading UI"), 0);
 	getSystemListView();
 
-	int i = 1;
-	int max = SystemData::sSystemVector.size() + 1;
-	bool splash = preloadUI && Settings::getInstance()->getBool("SplashScreen") && Settings::getInstance()->getBool("SplashScreenProgress");
+	std::vector<std::pair<SystemData*, FileData*>> systems;
 
-	for(auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
-	{		
+	for (auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
+	{
 		if ((*it)->isGroupChildSystem() || !(*it)->isVisible())
 			continue;
 
+		(*it)->resetFilters();
+		(*it)->setUIModeFilters();
+		(*it)->updateDisplayedGameCount();
+
+		systems.push_back(std::pair<SystemData*, FileData*>(*it, nullptr));
+	}
+
+	// The views are built in the background and attached on the next frames : the UI doesn't wait for them
+	if (std::thread::hardware_concurrency() > 1 && Settings::getInstance()->getBool("ThreadedLoading"))
+	{
+		startGameListModels(systems);
+		return;
+	}
+
+	int i = 1;
+	int max = systems.size() + 1;
+	bool splash = Settings::getInstance()->getBool("SplashScreen") && Settings::getInstance()->getBool("SplashScreenProgress");
+
+	for (auto system : systems)
+	{
 		if (splash)
 		{
 			i++;
@@ -986,8 +1183,7 @@ void ViewController::preload()
 				mWindow->renderSplashScreen(_("Preloading UI"), (float)i / (float)max);
 		}
 
-		(*it)->resetFilters();
-		getGameListView(*it);
+		getGameListView(system.first);
 	}
 }
 
@@ -1004,6 +1200,8 @@ void ViewController::reloadGameListView(IGameListView* view)
 	if (view == nullptr)
 		return;
 
+	cancelGameListModels();
+
 	Vector3f position = view->getPosition();
 
 	bool isCurrent = mCurrentView != nullptr && mCurrentView.get() == view;
@@ -1080,6 +1278,14 @@ ViewController::ViewMode ViewController::getViewMode()
 
 void ViewController::reloadAll(Window* window, bool reloadTheme)
 {
+	cancelGameListModels();
+
+	// Without reloading the themes, the ones of a previous progressive reload are still needed
+	if (reloadTheme)
+		cancelThemeReload();
+	else
+		completeThemeReload();
+
 	Utils::FileSystem::FileSystemCacheActivator fsc;
 
 	if (mCurrentView != nullptr)
@@ -1098,20 +1304,37 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 	if (mState.viewing == SYSTEM_SELECT)
 		system = getSelectedSystem();
 
+	// Progressive reload : only the themes of the current system and of its neighbours are loaded now.
+	// The others are loaded in the background and swapped in on the next frames, their views are kept until then
+	std::vector<SystemData*> pendingThemes;
+
+	SystemData* currentSystem = (mState.viewing == GAME_LIST ? mState.getSystem() : system);
+	if (reloadTheme && currentSystem != nullptr && std::thread::hardware_concurrency() > 1 && Settings::getInstance()->getBool("ThreadedLoading"))
+		pendingThemes = getThemeReloadOrder(currentSystem);
+
+	auto isPending = [&pendingThemes](SystemData* sys) { return std::find(pendingThemes.cbegin(), pendingThemes.cend(), sys) != pendingThemes.cend(); };
+
 	int gameListCount = 0;
 	// clear all gamelistviews
 	std::map<SystemData*, FileData*> cursorMap;
+	std::map<SystemData*, std::shared_ptr<IGameListView>> keptViews;
 	for (auto it = mGameListViews.cbegin(); it != mGameListViews.cend(); it++)
 	{
+		if (isPending(it->first))
+		{
+			keptViews[it->first] = it->second;
+			continue;
+		}
+
 		gameListCount++;
 		cursorMap[it->first] = it->second->getCursor();
 	}
 
-	mGameListViews.clear();
+	mGameListViews = keptViews;
 	
 	// If preloaded is disabled
 	for (auto it = SystemData::sSystemVector.cbegin(); it != SystemData::sSystemVector.cend(); it++)
-		if (cursorMap.find((*it)) == cursorMap.end())
+		if (cursorMap.find((*it)) == cursorMap.end() && !isPending(*it))
 			cursorMap[(*it)] = NULL;
 	
 	if (reloadTheme && cursorMap.size() > 0)
@@ -1147,6 +1370,10 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 	}
 
 	bool preloadUI = Settings::getInstance()->getBool("PreloadUI");
+	bool backgroundLoading = preloadUI && std::thread::hardware_concurrency() > 1 && Settings::getInstance()->getBool("ThreadedLoading");
+
+	// Views that are not displayed are rebuilt in the background, after the reload
+	std::vector<std::pair<SystemData*, FileData*>> backgroundViews;
 
 	if (gameListCount > 0)
 	{
@@ -1162,7 +1389,15 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 			if (it->second == nullptr)
 				continue;
 
-			if (preloadUI)
+			bool isCurrent = mState.viewing == GAME_LIST && mState.getSystem() == it->first;
+
+			if (backgroundLoading && !isCurrent)
+			{
+				it->first->setUIModeFilters();
+				it->first->updateDisplayedGameCount();
+				backgroundViews.push_back(*it);
+			}
+			else if (preloadUI)
 				getGameListView(it->first)->setCursor(it->second);
 			else if (mState.viewing == GAME_LIST)
 			{
@@ -1189,7 +1424,7 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 		for (auto sys : SystemData::sSystemVector)
 		{
 			auto theme = sys->getTheme();
-			if (theme != nullptr)
+			if (theme != nullptr && !isPending(sys))
 			{
 				ViewController::get()->onThemeChanged(theme);
 				break;
@@ -1219,6 +1454,179 @@ void ViewController::reloadAll(Window* window, bool reloadTheme)
 		mCurrentView->onShow();
 
 	updateHelpPrompts();
+
+	startGameListModels(backgroundViews);
+	startThemeReload(pendingThemes);
+}
+
+// All the systems but the current one and its direct neighbours in the carousel, which are loaded right away.
+// Nearest first in the carousel, the systems it doesn't show (hidden, grouped) come last
+std::vector<SystemData*> ViewController::getThemeReloadOrder(SystemData* current)
+{
+	std::vector<SystemData*> ret;
+
+	// A grouped system is reached from its group in the carousel
+	SystemData* selected = current;
+	if (selected->isGroupChildSystem() && selected->getParentGroupSystem() != nullptr)
+		selected = selected->getParentGroupSystem();
+
+	std::vector<SystemData*> carousel;
+	std::vector<SystemData*> hidden;
+
+	for (auto system : SystemData::sSystemVector)
+	{
+		if (system->isVisible())
+			carousel.push_back(system);
+		else if (system != current)
+			hidden.push_back(system);
+	}
+
+	auto it = std::find(carousel.cbegin(), carousel.cend(), selected);
+	if (it == carousel.cend())
+		return ret;
+
+	int count = (int)carousel.size();
+	int index = (int)(it - carousel.cbegin());
+
+	for (int distance = 2; distance <= count / 2; distance++)
+	{
+		SystemData* next = carousel.at((index + distance) % count);
+		SystemData* previous = carousel.at((index - distance + count) % count);
+
+		ret.push_back(next);
+		if (previous != next)
+			ret.push_back(previous);
+	}
+
+	ret.insert(ret.end(), hidden.cbegin(), hidden.cend());
+	return ret;
+}
+
+void ViewController::startThemeReload(const std::vector<SystemData*>& systems)
+{
+	if (systems.size() == 0)
+		return;
+
+	mThemeThreadCancel = false;
+	mPendingThemes = (int)systems.size();
+
+	mThemeThread = new std::thread([this, systems]
+	{
+		// In the order of the systems : nearest first.
+		// The default theme is a global read by the UI thread : it's only set when the theme is applied
+		for (auto system : systems)
+		{
+			std::shared_ptr<ThemeData> theme;
+			if (!mThemeThreadCancel)
+				theme = system->createTheme(false);
+
+			std::unique_lock<std::mutex> lock(mThemeLock);
+
+			if (theme != nullptr)
+				mLoadedThemes.push_back(std::pair<SystemData*, std::shared_ptr<ThemeData>>(system, theme));
+
+			mPendingThemes--;
+		}
+	});
+}
+
+void ViewController::cancelThemeReload()
+{
+	if (mThemeThread != nullptr)
+	{
+		mThemeThreadCancel = true;
+		mThemeThread->join();
+
+		delete mThemeThread;
+		mThemeThread = nullptr;
+	}
+
+	std::unique_lock<std::mutex> lock(mThemeLock);
+	mLoadedThemes.clear();
+}
+
+// Waits for the themes that are still loading, and sets them all without updating the views
+void ViewController::completeThemeReload()
+{
+	if (mThemeThread == nullptr)
+		return;
+
+	mThemeThread->join();
+
+	delete mThemeThread;
+	mThemeThread = nullptr;
+
+	std::unique_lock<std::mutex> lock(mThemeLock);
+
+	for (auto& loaded : mLoadedThemes)
+	{
+		loaded.first->setTheme(loaded.second);
+		ThemeData::setDefaultTheme(loaded.second.get());
+	}
+
+	mLoadedThemes.clear();
+}
+
+void ViewController::swapLoadedThemes()
+{
+	if (mThemeThread == nullptr)
+		return;
+
+	int start = SDL_GetTicks();
+
+	do
+	{
+		std::pair<SystemData*, std::shared_ptr<ThemeData>> loaded(nullptr, nullptr);
+		bool done = false;
+
+		{
+			std::unique_lock<std::mutex> lock(mThemeLock);
+
+			if (mLoadedThemes.size() > 0)
+			{
+				loaded = mLoadedThemes.front();
+				mLoadedThemes.erase(mLoadedThemes.begin());
+			}
+			else
+				done = (mPendingThemes == 0);
+		}
+
+		if (loaded.first == nullptr)
+		{
+			if (done)
+				cancelThemeReload();
+
+			return;
+		}
+
+		applyLoadedTheme(loaded.first, loaded.second);
+	} 
+	while ((int)SDL_GetTicks() - start < THEME_SWAP_FRAME_BUDGET);
+}
+
+void ViewController::applyLoadedTheme(SystemData* system, const std::shared_ptr<ThemeData>& theme)
+{
+	system->setTheme(theme);
+
+	// Like a theme loaded on the UI thread, it becomes the default one
+	ThemeData::setDefaultTheme(theme.get());
+
+	if (mSystemListView != nullptr)
+		mSystemListView->reloadTheme(system);
+
+	auto it = mGameListViews.find(system);
+	if (it == mGameListViews.cend())
+		return;
+
+	if (mCurrentView == it->second)
+	{
+		reloadGameListView(it->second.get());
+		return;
+	}
+
+	// Other views are built again when they are needed
+	system->resetFilters();
+	mGameListViews.erase(it);
 }
 
 std::vector<HelpPrompt> ViewController::getHelpPrompts()
@@ -7,6 +7,9 @@
 #include "GuiComponent.h"
 #include <vector>
 #include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 class IGameListView;
 class ISimpleGameListView;
@@ -109,6 +112,11 @@ public:
 
 	void setActiveView(std::shared_ptr<GuiComponent> view);
 
+	// Stops the background construction of gamelist views started by preload or reloadAll
+	void cancelGameListModels();
+	// Stops the background loading of the themes started by reloadAll. The systems that were not reached keep their previous theme
+	void cancelThemeReload();
+
 private:
 	ViewController(Window* window);
 	static ViewController* sInstance;
@@ -117,6 +125,54 @@ private:
 	bool doLaunchGame(FileData* game, LaunchGameOptions options);
 	bool checkLaunchOptions(FileData* game, LaunchGameOptions options, Vector3f center);
 	int getSystemId(SystemData* system);
+
+	// What is slow to build in a gamelist view and doesn't need the UI : the view type and the display list.
+	// Prepared from the settings and the theme on the UI thread, filled on a worker thread, then the view is created from it on the UI thread
+	struct GameListModel
+	{
+		GameListModel() : viewType(AUTOMATIC), detectViewType(false), allowDetailedDowngrade(false), themeHasVideoView(false), localArt(false), cursor(nullptr) { }
+
+		GameListViewType viewType;
+		bool detectViewType; // automatic view type, not detected yet
+		bool allowDetailedDowngrade;
+
+		std::string customThemeName;
+		Vector2f gridSizeOverride;
+
+		// Read when the model is prepared : the worker doesn't touch the settings nor the theme
+		std::string themeDefaultView;
+		bool themeHasVideoView;
+		bool localArt;
+
+		std::vector<FileData*> entries;
+		FileData* cursor;
+	};
+
+	void prepareGameListModel(SystemData* system, GameListModel& model);
+	void fillGameListModel(SystemData* system, GameListModel& model, bool onUiThread);
+	GameListViewType detectGameListViewType(SystemData* system, const GameListModel& model);
+
+	void startGameListModels(const std::vector<std::pair<SystemData*, FileData*>>& systems);
+	void attachGameListModel();
+
+	std::thread*			mModelThread;
+	std::atomic<bool>		mModelThreadCancel;
+	int						mPendingModels; // still building, guarded by mModelLock
+	std::mutex				mModelLock;
+	std::map<SystemData*, std::shared_ptr<GameListModel>> mGameListModels; // ready to be attached
+
+	// Progressive theme reload : the themes are loaded on worker threads, and swapped in on the UI thread within a frame budget
+	std::vector<SystemData*> getThemeReloadOrder(SystemData* current);
+	void startThemeReload(const std::vector<SystemData*>& systems);
+	void completeThemeReload();
+	void swapLoadedThemes();
+	void applyLoadedTheme(SystemData* system, const std::shared_ptr<ThemeData>& theme);
+
+	std::thread*			mThemeThread;
+	std::atomic<bool>		mThemeThreadCancel;
+	int						mPendingThemes; // still loading, guarded by mThemeLock
+	std::mutex				mThemeLock;
+	std::vector<std::pair<SystemData*, std::shared_ptr<ThemeData>>> mLoadedThemes; // ready to be swapped in
 	
 	std::shared_ptr<GuiComponent> mCurrentView;
 	std::map< SystemData*, std::shared_ptr<IGameListView> > mGameListViews;
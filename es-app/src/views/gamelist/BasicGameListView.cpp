@@ -11,7 +11,7 @@
 #include "LocaleES.h"
 #include "GameNameFormatter.h"
 
-BasicGameListView::BasicGameListView(Window* window, FolderData* root)
+BasicGameListView::BasicGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries)
 	: ISimpleGameListView(window, root), mList(window)
 {
 	mList.setSize(mSize.x(), mSize.y() * 0.8f);
@@ -26,7 +26,10 @@ BasicGameListView::BasicGameListView(Window* window, FolderData* root)
 
 	addChild(&mList);
 
-	populateList(root->getChildrenListToDisplay());
+	if (entries != nullptr)
+		populateList(*entries);
+	else
+		populateList(root->getChildrenListToDisplay());
 }
 
 void BasicGameListView::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
@@ -75,7 +78,10 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 			mList.add(". .", placeholder, true);
 		}
 
+		// Display names are only formatted for the entries the list shows
 		GameNameFormatter formatter(mRoot->getSystem());
+		mList.setEntryLoader([formatter](IList<TextListData, FileData*>::Entry& entry) mutable { entry.name = formatter.getDisplayName(entry.object); });
+		mList.reserve(mList.size() + (int)files.size());
 
 		bool favoritesFirst = mRoot->getSystem()->getShowFavoritesFirst();
 		if (favoritesFirst)
@@ -85,7 +91,7 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 				if (!file->getFavorite())
 					continue;
 						
-				mList.add(formatter.getDisplayName(file), file, file->getType() == FOLDER);
+				mList.addUnloaded(file, file->getType() == FOLDER);
 			}
 		}
 
@@ -94,7 +100,7 @@ void BasicGameListView::populateList(const std::vector<FileData*>& files)
 			if (favoritesFirst && file->getFavorite())
 				continue;
 				
-			mList.add(formatter.getDisplayName(file), file, file->getType() == FOLDER);
+			mList.addUnloaded(file, file->getType() == FOLDER);
 		}
 
 		// if we have the ".." PLACEHOLDER, then select the first game instead of the placeholder
@@ -8,7 +8,8 @@
 class BasicGameListView : public ISimpleGameListView
 {
 public:
-	BasicGameListView(Window* window, FolderData* root);
+	// entries : display list of root, when it was built beforehand
+	BasicGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries = nullptr);
 
 	// Called when a FileData* is added, has its metadata changed, or is removed
 	virtual void onFileChanged(FileData* file, FileChangeType change);
@@ -31,6 +32,8 @@ public:
 
 	virtual void launch(FileData* game) override;
 	virtual std::vector<FileData*> getFileDataEntries() override;
+	virtual int getFileDataCount() override { return mList.size(); }
+	virtual FileData* getFileDataAt(int index) override { return mList.getObjectAt(index); }
 
 protected:
 	virtual std::string getQuickSystemSelectRightButton() override;
@@ -11,7 +11,7 @@
 #include "LocaleES.h"
 #include "GameNameFormatter.h"
 
-CarouselGameListView::CarouselGameListView(Window* window, FolderData* root)
+CarouselGameListView::CarouselGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries)
 	: ISimpleGameListView(window, root),
 	mList(window), mDetails(this, &mList, mWindow, DetailedContainer::DetailedView)
 {
@@ -27,7 +27,10 @@ CarouselGameListView::CarouselGameListView(Window* window, FolderData* root)
 		
 	addChild(&mList);
 
-	populateList(root->getChildrenListToDisplay());
+	if (entries != nullptr)
+		populateList(*entries);
+	else
+		populateList(root->getChildrenListToDisplay());
 }
 
 void CarouselGameListView::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
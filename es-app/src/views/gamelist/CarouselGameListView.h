@@ -9,7 +9,7 @@
 class CarouselGameListView : public ISimpleGameListView
 {
 public:
-	CarouselGameListView(Window* window, FolderData* root);
+	CarouselGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries = nullptr);
 
 	// Called when a FileData* is added, has its metadata changed, or is removed
 	virtual void onFileChanged(FileData* file, FileChangeType change);
@@ -32,6 +32,8 @@ public:
 
 	virtual void launch(FileData* game) override;
 	virtual std::vector<FileData*> getFileDataEntries() override;
+	virtual int getFileDataCount() override { return mList.size(); }
+	virtual FileData* getFileDataAt(int index) override { return mList.getObjectAt(index); }
 	virtual void update(int deltaTime) override;
 
 protected:
@@ -10,6 +10,7 @@
 #include "SystemConf.h"
 #include "Window.h"
 #include "components/ComponentGrid.h"
+#include "views/gamelist/FolderMosaic.h"
 #include <set>
 
 #ifdef _RPI_
@@ -18,6 +19,8 @@
 #endif
 #include "components/VideoVlcComponent.h"
 
+#define GRIDPADDING Renderer::getScreenHeight() * 0.004f
+
 DetailedContainer::DetailedContainer(ISimpleGameListView* parent, GuiComponent* list, Window* window, DetailedContainerType viewType) :
 	mParent(parent), mList(list), mWindow(window), mViewType(viewType),
 	mDescription(window),
@@ -35,7 +38,20 @@ DetailedContainer::DetailedContainer(ISimpleGameListView* parent, GuiComponent*
 
 	mRating(window), mReleaseDate(window), mDeveloper(window), mPublisher(window),
 	mGenre(window), mPlayers(window), mLastPlayed(window), mPlayCount(window),
-	mName(window), mGameTime(window), mTextFavorite(window)	
+	mName(window), mGameTime(window), mTextFavorite(window),
+
+	mPrefetcher([this](FileData* file, std::vector<std::shared_ptr<TextureResource>>& textures) 
+	{ 
+		getPrefetchTextures(file, textures); 
+
+		if (file->getType() == GAME)
+			mPresentations.request(file);
+		else if (file->getType() == FOLDER)
+		{
+			Vector2f size = getFolderGridSize();
+			FolderMosaic::get(getFolderThumbs(((FolderData*)file)->getChildrenListToDisplay()), Vector2i(size.x(), size.y()), GRIDPADDING);
+		}
+	})
 {
 	std::vector<MdImage> mdl = 
 	{ 
@@ -432,6 +448,20 @@ void DetailedContainer::onThemeChanged(const std::shared_ptr<ThemeData>& theme)
 		addChild(extra);
 
 	mParent->sortChildren();
+
+	updatePresentationOptions();
+}
+
+void DetailedContainer::updatePresentationOptions()
+{
+	GamePresentation::Options options;
+	options.snapshotSource = mVideo != nullptr ? (int)mVideo->getSnapshotSource() : -1;
+	options.playersAsOne = (mPlayers.getOriginalThemeText() == "1");
+
+	for (auto& md : mdImages)
+		options.mdImages.push_back(md.metaDataIds);
+
+	mPresentations.setOptions(options);
 }
 
 Vector3f DetailedContainer::getLaunchTarget()
@@ -448,15 +478,48 @@ Vector3f DetailedContainer::getLaunchTarget()
 	return target;
 }
 
-#define GRIDPADDING Renderer::getScreenHeight() * 0.004f
+std::vector<std::string> DetailedContainer::getFolderThumbs(const std::vector<FileData*>& games)
+{
+	std::vector<std::string> thumbs;
+
+	for (auto child : games)
+		if (!child->getThumbnailPath().empty())
+			thumbs.push_back(child->getThumbnailPath());
+
+	return thumbs;
+}
+
+// Size of the folder preview, with the same choice of component as updateDetailsForFolder
+Vector2f DetailedContainer::getFolderGridSize()
+{
+	if (mVideo != nullptr && mVideo->showSnapshots())
+		return mVideo->getTargetSize();
+
+	if (mImage != nullptr)
+		return mImage->getSize();
+
+	return Vector2f::Zero();
+}
 
 void DetailedContainer::createFolderGrid(Vector2f targetSize, std::vector<std::string> thumbs)
 {
 	if (thumbs.size() == 0)
 		return;
 
-	auto gridSize = Vector2i(3, 2);
-	mFolderView = new ComponentGrid(mWindow, gridSize);
+	// A single texture when the mosaic is ready, otherwise one image per thumbnail while it's composed
+	std::string mosaic = FolderMosaic::get(thumbs, Vector2i(targetSize.x(), targetSize.y()), GRIDPADDING);
+	if (!mosaic.empty())
+	{
+		auto image = new ImageComponent(mWindow);
+		image->setIsLinear(true);
+		image->setImage(mosaic);
+		image->setResize(targetSize);
+		mFolderView = image;
+		return;
+	}
+
+	auto gridSize = FolderMosaic::GRID_SIZE;
+	auto grid = new ComponentGrid(mWindow, gridSize);
 
 	auto sz = Vector2f(targetSize.x() / (float)gridSize.x(), targetSize.y() / (float)gridSize.y());
 
@@ -473,12 +536,13 @@ void DetailedContainer::createFolderGrid(Vector2f targetSize, std::vector<std::s
 			image->setIsLinear(true);
 			image->setImage(thumbs[idx]);
 			image->setPadding(Vector4f(GRIDPADDING, GRIDPADDING, GRIDPADDING, GRIDPADDING));
-			mFolderView->setEntry(image, Vector2i(x, y), false, false);
+			grid->setEntry(image, Vector2i(x, y), false, false);
 			idx++;
 		}
 	}
 
-	mFolderView->setSize(targetSize);
+	grid->setSize(targetSize);
+	mFolderView = grid;
 }
 
 void DetailedContainer::updateFolderViewAmbiantProperties()
@@ -529,14 +593,14 @@ void DetailedContainer::updateDetailsForFolder(FolderData* folder)
 
 	FileData* firstGameWithImage = nullptr;
 
-	std::vector<std::string> thumbs;
+	std::vector<std::string> thumbs = getFolderThumbs(games);
 	for (auto child : games)
 	{
-		if (!child->getThumbnailPath().empty())
-			thumbs.push_back(child->getThumbnailPath());
-
-		if (firstGameWithImage == nullptr && !child->getImagePath().empty())
-			firstGameWithImage = child;		
+		if (!child->getImagePath().empty())
+		{
+			firstGameWithImage = child;
+			break;
+		}
 	}
 
 
@@ -619,6 +683,44 @@ void DetailedContainer::updateDetailsForFolder(FolderData* folder)
 	mGameTime.setValue("");
 }
 
+std::string DetailedContainer::getMdImagePath(FileData* file, const MdImage& md)
+{
+	return GamePresentation::getMdImagePath(file, md.metaDataIds);
+}
+
+// Same images as updateControls. Videos and their snapshots are not prefetched : they are read synchronously when they start
+void DetailedContainer::getPrefetchTextures(FileData* file, std::vector<std::shared_ptr<TextureResource>>& textures)
+{
+	auto prefetch = [&textures](ImageComponent* image, const std::string& path)
+	{
+		std::shared_ptr<TextureResource> texture = image->prefetchImage(path);
+		if (texture != nullptr)
+			textures.push_back(texture);
+	};
+
+	std::string imagePath = file->getImagePath().empty() ? file->getThumbnailPath() : file->getImagePath();
+
+	if (mThumbnail != nullptr)
+	{
+		if (mViewType == DetailedContainerType::VideoView && mImage != nullptr)
+			prefetch(mImage, file->getImagePath());
+
+		prefetch(mThumbnail, file->getThumbnailPath());
+	}
+
+	if (mImage != nullptr)
+	{
+		if (mViewType == DetailedContainerType::VideoView && mThumbnail == nullptr)
+			prefetch(mImage, file->getThumbnailPath());
+		else if (mViewType != DetailedContainerType::VideoView)
+			prefetch(mImage, imagePath);
+	}
+
+	for (auto& md : mdImages)
+		if (md.component != nullptr)
+			prefetch(md.component, getMdImagePath(file, md));
+}
+
 void DetailedContainer::updateControls(FileData* file, bool isClearing, int moveBy, bool isDeactivating)
 {
 	bool state = (file != NULL);
@@ -630,80 +732,41 @@ void DetailedContainer::updateControls(FileData* file, bool isClearing, int move
 			mFolderView = nullptr;
 		}
 
-		std::string imagePath = file->getImagePath().empty() ? file->getThumbnailPath() : file->getImagePath();
+		// Paths and texts are ready when the game was predicted by the prefetcher
+		std::shared_ptr<GamePresentation> model = mPresentations.take(file);
+
+		std::string imagePath = model->imagePath.empty() ? model->thumbnailPath : model->imagePath;
 
 		if (mVideo != nullptr)
 		{
-			if (!mVideo->setVideo(file->getVideoPath()))
+			if (!mVideo->setVideo(model->videoPath))
 				mVideo->setDefaultVideo();
 
-			std::string snapShot = imagePath;
-
-			auto src = mVideo->getSnapshotSource();
-
-			if (src == TITLESHOT && Utils::FileSystem::exists(file->getMetadata(MetaDataId::TitleShot)))
-				snapShot = file->getMetadata(MetaDataId::TitleShot);
-			else if (src == BOXART && Utils::FileSystem::exists(file->getMetadata(MetaDataId::BoxArt)))
-				snapShot = file->getMetadata(MetaDataId::BoxArt);
-			else if (src == MARQUEE && !file->getMarqueePath().empty())
-				snapShot = file->getMarqueePath();
-			else if ((src == THUMBNAIL || src == BOXART) && !file->getThumbnailPath().empty())
-				snapShot = file->getThumbnailPath();			
-			else if ((src == IMAGE || src == TITLESHOT) && !file->getImagePath().empty())
-				snapShot = file->getImagePath();
-			else if (src == FANART && Utils::FileSystem::exists(file->getMetadata(MetaDataId::FanArt)))
-				snapShot = file->getMetadata(MetaDataId::FanArt);
-			else if (src == CARTRIDGE && Utils::FileSystem::exists(file->getMetadata(MetaDataId::Cartridge)))
-				snapShot = file->getMetadata(MetaDataId::Cartridge);
-			else if (src == MIX && Utils::FileSystem::exists(file->getMetadata(MetaDataId::Mix)))
-				snapShot = file->getMetadata(MetaDataId::Mix);
-
-			mVideo->setImage(snapShot);
+			mVideo->setImage(model->snapshotPath);
 		}
 
 		if (mThumbnail != nullptr)
 		{
 			if (mViewType == DetailedContainerType::VideoView && mImage != nullptr)
-				mImage->setImage(file->getImagePath(), false, mImage->getMaxSizeInfo());
+				mImage->setImage(model->imagePath, false, mImage->getMaxSizeInfo());
 
-			mThumbnail->setImage(file->getThumbnailPath(), false, mThumbnail->getMaxSizeInfo());
+			mThumbnail->setImage(model->thumbnailPath, false, mThumbnail->getMaxSizeInfo());
 		}
 		
 		if (mImage != nullptr)
 		{
 			if (mViewType == DetailedContainerType::VideoView && mThumbnail == nullptr)
-				mImage->setImage(file->getThumbnailPath(), false, mImage->getMaxSizeInfo());
+				mImage->setImage(model->thumbnailPath, false, mImage->getMaxSizeInfo());
 			else if (mViewType != DetailedContainerType::VideoView)
 				mImage->setImage(imagePath, false, mImage->getMaxSizeInfo());
 		}
 
-		for (auto& md : mdImages)
+		for (int i = 0; i < (int)mdImages.size(); i++)
 		{
+			auto& md = mdImages[i];
 			if (md.component != nullptr)
 			{
-				std::string image;
-
-				for (auto& id : md.metaDataIds)
-				{
-					if (id == MetaDataId::Marquee)
-					{
-						if (Utils::FileSystem::exists(file->getMarqueePath()))
-						{
-							image = file->getMarqueePath();
-							break;
-						}
-
-						continue;
-					}
-
-					std::string path = file->getMetadata(id);
-					if (Utils::FileSystem::exists(path)) 
-					{
-						image = path;
-						break;
-					}
-				}
-
+				std::string image = i < (int)model->mdImagePaths.size() ? model->mdImagePaths[i] : "";
 				if (!image.empty())
 					md.component->setImage(image, false, md.component->getMaxSizeInfo());
 				else
@@ -723,7 +786,7 @@ void DetailedContainer::updateControls(FileData* file, bool isClearing, int move
 				mFlag->setImage(":/folder.svg");
 		}
 
-		bool hasManualOrMagazine = Utils::FileSystem::exists(file->getMetadata(MetaDataId::Manual)) || Utils::FileSystem::exists(file->getMetadata(MetaDataId::Magazine));
+		bool hasManualOrMagazine = model->hasManualOrMagazine;
 
 		if (mManual != nullptr)
 			mManual->setVisible(hasManualOrMagazine);
@@ -732,10 +795,10 @@ void DetailedContainer::updateControls(FileData* file, bool isClearing, int move
 			mNoManual->setVisible(!hasManualOrMagazine);
 
 		if (mMap != nullptr)
-			mMap->setVisible(Utils::FileSystem::exists(file->getMetadata(MetaDataId::Map)));
+			mMap->setVisible(model->hasMap);
 
 		if (mNoMap != nullptr)
-			mNoMap->setVisible(!Utils::FileSystem::exists(file->getMetadata(MetaDataId::Map)));
+			mNoMap->setVisible(!model->hasMap);
 
 		// Save states
 		bool hasSaveState = false;
@@ -779,51 +842,34 @@ void DetailedContainer::updateControls(FileData* file, bool isClearing, int move
 		if (mHidden != nullptr)
 			mHidden->setVisible(file->getHidden());
 	
-		mDescription.setText(file->getMetadata(MetaDataId::Desc));
-
-		auto valueOrUnknown = [](const std::string value) { return value.empty() ? _("Unknown") : value; };
-		auto valueOrOne = [](const std::string value) 
-		{ 
-			auto split = value.rfind("+");
-			if (split != std::string::npos)
-				return value.substr(0, split);
-
-			split = value.rfind("-");
-			if (split != std::string::npos)
-				return value.substr(split + 1);
+		mDescription.setText(model->description);
 
-			std::string ret = value;
+		mRating.setValue(model->rating);
+		mReleaseDate.setValue(model->releaseDate);
+		mDeveloper.setValue(model->developer);
+		mPublisher.setValue(model->publisher);
+		mGenre.setValue(model->genre);
+		mPlayers.setValue(model->players);
 
-			int count = Utils::String::toInteger(value);
-
-			if (count >= 10) ret = "9";
-			else if (count == 0) ret = "1";
-
-			return ret;
-		};
-
-		mRating.setValue(file->getMetadata(MetaDataId::Rating));
-		mReleaseDate.setValue(file->getMetadata(MetaDataId::ReleaseDate));
-		mDeveloper.setValue(valueOrUnknown(file->getMetadata(MetaDataId::Developer)));
-		mPublisher.setValue(valueOrUnknown(file->getMetadata(MetaDataId::Publisher)));
-		mGenre.setValue(valueOrUnknown(file->getMetadata(MetaDataId::Genre)));
-
-		if (mPlayers.getOriginalThemeText() == "1")
-			mPlayers.setValue(valueOrOne(file->getMetadata(MetaDataId::Players)));
-		else 
-			mPlayers.setValue(valueOrUnknown(file->getMetadata(MetaDataId::Players)));
-
-		mName.setValue(file->getMetadata(MetaDataId::Name));
+		mName.setValue(model->name);
 		mTextFavorite.setText(file->getFavorite()?_("YES"):_("NO"));
 
 		if (file->getType() == GAME)
 		{
-			mLastPlayed.setValue(file->getMetadata(MetaDataId::LastPlayed));
-			mPlayCount.setValue(file->getMetadata(MetaDataId::PlayCount));
-			mGameTime.setValue(Utils::Time::secondsToString(atol(file->getMetadata(MetaDataId::GameTime).c_str())));
+			mLastPlayed.setValue(model->lastPlayed);
+			mPlayCount.setValue(model->playCount);
+			mGameTime.setValue(model->gameTime);
 		}
 		else if (file->getType() == FOLDER)
 			updateDetailsForFolder((FolderData*)file);
+
+		if (!isDeactivating)
+			mPrefetcher.onCursorChanged(mParent, file, moveBy);
+	}
+	else
+	{
+		mPrefetcher.clear();
+		mPresentations.clear();
 	}
 
 	std::vector<GuiComponent*> comps = getComponents();
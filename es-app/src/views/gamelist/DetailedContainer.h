@@ -4,6 +4,8 @@
 #include "components/RatingComponent.h"
 #include "components/ScrollableContainer.h"
 #include "views/gamelist/BasicGameListView.h"
+#include "views/gamelist/GamePresentation.h"
+#include "views/gamelist/MediaPrefetcher.h"
 
 class VideoComponent;
 class ComponentGrid;
@@ -123,13 +125,22 @@ protected:
 	DateTimeComponent mReleaseDate, mLastPlayed;
 
 	std::vector<MdImage> mdImages;
+	std::string getMdImagePath(FileData* file, const MdImage& md);
 
 	std::vector<GuiComponent*> mThemeExtras;
 
+	std::vector<std::string> getFolderThumbs(const std::vector<FileData*>& games);
+	Vector2f getFolderGridSize();
 	void createFolderGrid(Vector2f targetSize, std::vector<std::string> thumbs);
-	ComponentGrid* mFolderView;
+	GuiComponent* mFolderView; // composed mosaic, or a grid of the thumbnails until the mosaic is ready
 
 	bool		mState;
+
+	void getPrefetchTextures(FileData* file, std::vector<std::shared_ptr<TextureResource>>& textures);
+	MediaPrefetcher mPrefetcher;
+
+	void updatePresentationOptions();
+	GamePresentationCache mPresentations;
 };
 
 
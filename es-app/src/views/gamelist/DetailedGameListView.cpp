@@ -6,8 +6,8 @@
 #include "SystemData.h"
 #include "LocaleES.h"
 
-DetailedGameListView::DetailedGameListView(Window* window, FolderData* root) : 
-	BasicGameListView(window, root), 
+DetailedGameListView::DetailedGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries) : 
+	BasicGameListView(window, root, entries), 
 	mDetails(this, &mList, mWindow, DetailedContainer::DetailedView)
 {
 	// Let DetailedContainer handle extras with activation scripts
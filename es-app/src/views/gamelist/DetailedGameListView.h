@@ -11,7 +11,7 @@
 class DetailedGameListView : public BasicGameListView
 {
 public:
-	DetailedGameListView(Window* window, FolderData* root);
+	DetailedGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries = nullptr);
 
 	virtual void onThemeChanged(const std::shared_ptr<ThemeData>& theme) override;
 	virtual void onShow() override;
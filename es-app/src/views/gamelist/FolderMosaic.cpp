@@ -0,0 +1,180 @@
+#include "views/gamelist/FolderMosaic.h"
+
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "utils/md5.h"
+#include "math/Misc.h"
+#include "ImageIO.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <set>
+
+// Folders queued while the cursor moves : only the latest ones are worth composing
+#define MOSAIC_QUEUE_SIZE 4
+
+// Mosaics kept on disk, the oldest ones are deleted beyond
+#define MOSAIC_CACHE_FILES 500
+
+const Vector2i FolderMosaic::GRID_SIZE(3, 2);
+
+std::thread*			FolderMosaic::mThread = nullptr;
+std::mutex				FolderMosaic::mLock;
+std::condition_variable	FolderMosaic::mEvent;
+bool					FolderMosaic::mExit = false;
+
+std::deque<FolderMosaic::Request>		FolderMosaic::mQueue;
+std::map<std::string, std::string>		FolderMosaic::mMosaics;
+int										FolderMosaic::mCachedFiles = -1;
+
+std::string FolderMosaic::getKey(const std::vector<std::string>& thumbs, const Vector2i& size, int padding)
+{
+	std::string key = std::to_string(size.x()) + "x" + std::to_string(size.y()) + "-" + std::to_string(padding);
+
+	// Dates of the thumbnails are part of the key : a scraped again thumbnail gives a new mosaic
+	int count = Math::min((int)thumbs.size(), GRID_SIZE.x() * GRID_SIZE.y());
+	for (int i = 0; i < count; i++)
+		key += "|" + thumbs[i] + "|" + Utils::FileSystem::getFileModificationDate(thumbs[i]).getIsoString();
+
+	return key;
+}
+
+std::string FolderMosaic::getCachePath()
+{
+	return Utils::FileSystem::getGenericPath(Utils::FileSystem::getEsConfigPath() + "/cache/folders");
+}
+
+std::string FolderMosaic::get(const std::vector<std::string>& thumbs, const Vector2i& size, int padding)
+{
+	if (thumbs.size() == 0 || size.x() <= 0 || size.y() <= 0)
+		return "";
+
+	std::string key = getKey(thumbs, size, padding);
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		auto it = mMosaics.find(key);
+		if (it != mMosaics.cend())
+			return it->second;
+
+		if (std::find_if(mQueue.cbegin(), mQueue.cend(), [key](const Request& request) { return request.key == key; }) != mQueue.cend())
+			return "";
+
+		Request request;
+		request.key = key;
+		request.thumbs = thumbs;
+		request.size = size;
+		request.padding = padding;
+
+		mQueue.push_back(request);
+		while (mQueue.size() > MOSAIC_QUEUE_SIZE)
+			mQueue.pop_front();
+	}
+
+	if (mThread == nullptr)
+		mThread = new std::thread(&FolderMosaic::run);
+
+	mEvent.notify_one();
+	return "";
+}
+
+void FolderMosaic::run()
+{
+	while (true)
+	{
+		Request request;
+
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			mEvent.wait(lock, [] { return mExit || !mQueue.empty(); });
+
+			if (mExit)
+				return;
+
+			request = mQueue.front();
+			mQueue.pop_front();
+		}
+
+		int count = Math::min((int)request.thumbs.size(), GRID_SIZE.x() * GRID_SIZE.y());
+		request.thumbs.resize(count);
+
+		std::string path = getCachePath() + "/" + MD5(request.key).hexdigest() + ".png";
+
+		if (!Utils::FileSystem::exists(path))
+		{
+			Utils::FileSystem::createDirectory(getCachePath());
+
+			if (!ImageIO::createMosaic(request.thumbs, GRID_SIZE.x(), GRID_SIZE.y(), request.size.x(), request.size.y(), request.padding, path))
+				path = "";
+			else
+			{
+				LOG(LogDebug) << "FolderMosaic::run\tComposed " << path;
+
+				if (mCachedFiles >= 0)
+					mCachedFiles++;
+			}
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			mMosaics[request.key] = path;
+		}
+
+		if (mCachedFiles < 0 || mCachedFiles > MOSAIC_CACHE_FILES)
+			prune();
+	}
+}
+
+// Deletes the oldest mosaics beyond MOSAIC_CACHE_FILES : those of renamed or scraped again folders are never used again
+void FolderMosaic::prune()
+{
+	std::vector<std::pair<Utils::Time::DateTime, std::string>> files;
+
+	for (auto file : Utils::FileSystem::getDirectoryFiles(getCachePath()))
+		if (!file.directory && Utils::String::toLower(Utils::FileSystem::getExtension(file.path)) == ".png")
+			files.push_back(std::pair<Utils::Time::DateTime, std::string>(Utils::FileSystem::getFileModificationDate(file.path), file.path));
+
+	mCachedFiles = (int)files.size();
+	if (mCachedFiles <= MOSAIC_CACHE_FILES)
+		return;
+
+	std::sort(files.begin(), files.end(), [](const std::pair<Utils::Time::DateTime, std::string>& a, const std::pair<Utils::Time::DateTime, std::string>& b) { return a.first < b.first; });
+
+	std::set<std::string> removed;
+
+	for (int i = 0; i < mCachedFiles - MOSAIC_CACHE_FILES; i++)
+		if (Utils::FileSystem::removeFile(files[i].second))
+			removed.insert(files[i].second);
+
+	mCachedFiles -= (int)removed.size();
+
+	LOG(LogDebug) << "FolderMosaic::prune\tDeleted " << removed.size() << " mosaics";
+
+	std::unique_lock<std::mutex> lock(mLock);
+
+	for (auto it = mMosaics.begin(); it != mMosaics.end(); )
+	{
+		if (removed.find(it->second) != removed.cend())
+			it = mMosaics.erase(it);
+		else
+			++it;
+	}
+}
+
+void FolderMosaic::stop()
+{
+	if (mThread == nullptr)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+		mExit = true;
+	}
+
+	mEvent.notify_one();
+	mThread->join();
+
+	delete mThread;
+	mThread = nullptr;
+}
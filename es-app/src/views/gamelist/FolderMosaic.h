@@ -0,0 +1,48 @@
+#pragma once
+
+#include "math/Vector2i.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Folder previews composed once into a single picture, instead of one texture per child thumbnail.
+// Mosaics are saved on disk under a name derived from the thumbnails and their dates, so they are rebuilt when the children change
+class FolderMosaic
+{
+public:
+	// Path of the mosaic of these thumbnails, or empty when it's not built yet : it's then queued on the worker thread
+	static std::string get(const std::vector<std::string>& thumbs, const Vector2i& size, int padding);
+
+	// Mosaics composed in a 3x2 grid, filled column by column
+	static const Vector2i GRID_SIZE;
+
+	static void stop();
+
+private:
+	struct Request
+	{
+		std::string key;
+		std::vector<std::string> thumbs;
+		Vector2i size;
+		int padding;
+	};
+
+	static std::string getKey(const std::vector<std::string>& thumbs, const Vector2i& size, int padding);
+	static std::string getCachePath();
+	static void run();
+	static void prune();
+
+	static std::thread*				mThread;
+	static std::mutex				mLock;
+	static std::condition_variable	mEvent;
+	static bool						mExit;
+
+	static std::deque<Request>					mQueue;
+	static std::map<std::string, std::string>	mMosaics; // key -> path, empty when the mosaic can't be built
+	static int									mCachedFiles; // mosaics on disk, -1 before they are counted
+};
@@ -0,0 +1,302 @@
+#include "views/gamelist/GamePresentation.h"
+
+#include "components/VideoComponent.h"
+#include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
+#include "utils/TimeUtil.h"
+#include "FileData.h"
+#include "LocaleES.h"
+#include "Settings.h"
+
+#include <algorithm>
+
+// Ready models kept for the games ahead of the cursor
+#define PRESENTATION_CACHE_SIZE 16
+
+std::string GamePresentation::getMdImagePath(FileData* file, const std::vector<MetaDataId>& metaDataIds)
+{
+	for (auto& id : metaDataIds)
+	{
+		if (id == MetaDataId::Marquee)
+		{
+			if (Utils::FileSystem::exists(file->getMarqueePath()))
+				return file->getMarqueePath();
+
+			continue;
+		}
+
+		std::string path = file->getMetadata(id);
+		if (Utils::FileSystem::exists(path))
+			return path;
+	}
+
+	return "";
+}
+
+void GamePresentation::resolvePaths(FileData* file, const Options& options)
+{
+	imagePath = file->getImagePath();
+	thumbnailPath = file->getThumbnailPath();
+	videoPath = file->getVideoPath();
+
+	if (options.snapshotSource >= 0)
+	{
+		snapshotPath = imagePath.empty() ? thumbnailPath : imagePath;
+
+		auto src = (ImageSource)options.snapshotSource;
+
+		if (src == TITLESHOT && Utils::FileSystem::exists(file->getMetadata(MetaDataId::TitleShot)))
+			snapshotPath = file->getMetadata(MetaDataId::TitleShot);
+		else if (src == BOXART && Utils::FileSystem::exists(file->getMetadata(MetaDataId::BoxArt)))
+			snapshotPath = file->getMetadata(MetaDataId::BoxArt);
+		else if (src == MARQUEE && !file->getMarqueePath().empty())
+			snapshotPath = file->getMarqueePath();
+		else if ((src == THUMBNAIL || src == BOXART) && !thumbnailPath.empty())
+			snapshotPath = thumbnailPath;
+		else if ((src == IMAGE || src == TITLESHOT) && !imagePath.empty())
+			snapshotPath = imagePath;
+		else if (src == FANART && Utils::FileSystem::exists(file->getMetadata(MetaDataId::FanArt)))
+			snapshotPath = file->getMetadata(MetaDataId::FanArt);
+		else if (src == CARTRIDGE && Utils::FileSystem::exists(file->getMetadata(MetaDataId::Cartridge)))
+			snapshotPath = file->getMetadata(MetaDataId::Cartridge);
+		else if (src == MIX && Utils::FileSystem::exists(file->getMetadata(MetaDataId::Mix)))
+			snapshotPath = file->getMetadata(MetaDataId::Mix);
+	}
+
+	mdImagePaths.clear();
+	for (auto& ids : options.mdImages)
+		mdImagePaths.push_back(getMdImagePath(file, ids));
+
+	pathsResolved = true;
+}
+
+void GamePresentation::build(FileData* file, const Options& options, bool resolve)
+{
+	if (resolve)
+		resolvePaths(file, options);
+
+	hasManualOrMagazine = Utils::FileSystem::exists(file->getMetadata(MetaDataId::Manual)) || Utils::FileSystem::exists(file->getMetadata(MetaDataId::Magazine));
+	hasMap = Utils::FileSystem::exists(file->getMetadata(MetaDataId::Map));
+
+	auto valueOrUnknown = [](const std::string value) { return value.empty() ? _("Unknown") : value; };
+	auto valueOrOne = [](const std::string value) 
+	{ 
+		auto split = value.rfind("+");
+		if (split != std::string::npos)
+			return value.substr(0, split);
+
+		split = value.rfind("-");
+		if (split != std::string::npos)
+			return value.substr(split + 1);
+
+		std::string ret = value;
+
+		int count = Utils::String::toInteger(value);
+
+		if (count >= 10) ret = "9";
+		else if (count == 0) ret = "1";
+
+		return ret;
+	};
+
+	name = file->getMetadata(MetaDataId::Name);
+	description = file->getMetadata(MetaDataId::Desc);
+	rating = file->getMetadata(MetaDataId::Rating);
+	releaseDate = file->getMetadata(MetaDataId::ReleaseDate);
+	developer = valueOrUnknown(file->getMetadata(MetaDataId::Developer));
+	publisher = valueOrUnknown(file->getMetadata(MetaDataId::Publisher));
+	genre = valueOrUnknown(file->getMetadata(MetaDataId::Genre));
+
+	if (options.playersAsOne)
+		players = valueOrOne(file->getMetadata(MetaDataId::Players));
+	else
+		players = valueOrUnknown(file->getMetadata(MetaDataId::Players));
+
+	if (file->getType() == GAME)
+	{
+		lastPlayed = file->getMetadata(MetaDataId::LastPlayed);
+		playCount = file->getMetadata(MetaDataId::PlayCount);
+		gameTime = Utils::Time::secondsToString(atol(file->getMetadata(MetaDataId::GameTime).c_str()));
+	}
+}
+
+std::thread*					GamePresentationCache::mThread = nullptr;
+std::mutex						GamePresentationCache::mLock;
+std::condition_variable			GamePresentationCache::mEvent;
+std::condition_variable			GamePresentationCache::mBuilt;
+bool							GamePresentationCache::mExit = false;
+
+std::deque<GamePresentationCache::Request>	GamePresentationCache::mQueue;
+GamePresentationCache::Request				GamePresentationCache::mBuilding;
+
+GamePresentationCache::GamePresentationCache() : mGeneration(0)
+{
+}
+
+GamePresentationCache::~GamePresentationCache()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	mQueue.erase(std::remove_if(mQueue.begin(), mQueue.end(), [this](const Request& request) { return request.cache == this; }), mQueue.end());
+
+	// The worker stores its model in this cache when it's done
+	mBuilt.wait(lock, [this] { return mBuilding.cache != this; });
+}
+
+void GamePresentationCache::setOptions(const GamePresentation::Options& options)
+{
+	clear();
+
+	std::unique_lock<std::mutex> lock(mLock);
+	mOptions = options;
+}
+
+void GamePresentationCache::clear()
+{
+	std::unique_lock<std::mutex> lock(mLock);
+
+	mGeneration++;
+	mQueue.erase(std::remove_if(mQueue.begin(), mQueue.end(), [this](const Request& request) { return request.cache == this; }), mQueue.end());
+	mModels.clear();
+	mModelOrder.clear();
+}
+
+std::shared_ptr<GamePresentation> GamePresentationCache::take(FileData* file)
+{
+	std::shared_ptr<GamePresentation> model;
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		// Building it here too would touch the metadata of the game from both threads
+		mBuilt.wait(lock, [this, file] { return mBuilding.cache != this || mBuilding.file != file; });
+
+		auto it = mModels.find(file);
+		if (it != mModels.cend())
+		{
+			model = it->second;
+			mModels.erase(it);
+
+			auto order = std::find(mModelOrder.begin(), mModelOrder.end(), file);
+			if (order != mModelOrder.end())
+				mModelOrder.erase(order);
+		}
+		else
+		{
+			auto queued = std::find_if(mQueue.begin(), mQueue.end(), [this, file](const Request& request) { return request.cache == this && request.file == file; });
+			if (queued != mQueue.end())
+				mQueue.erase(queued);
+		}
+	}
+
+	if (model == nullptr)
+	{
+		model = std::make_shared<GamePresentation>();
+		model->build(file, mOptions, true);
+	}
+	else if (!model->pathsResolved)
+		model->resolvePaths(file, mOptions);
+
+	return model;
+}
+
+void GamePresentationCache::request(FileData* file)
+{
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+
+		if (mModels.find(file) != mModels.cend() || (mBuilding.cache == this && mBuilding.file == file))
+			return;
+
+		int pending = 0;
+		for (auto& request : mQueue)
+		{
+			if (request.cache != this)
+				continue;
+
+			if (request.file == file)
+				return;
+
+			pending++;
+		}
+
+		mQueue.push_back(Request(this, file));
+
+		// Only the games the cursor is heading to are worth building
+		if (pending >= PRESENTATION_CACHE_SIZE)
+			mQueue.erase(std::find_if(mQueue.begin(), mQueue.end(), [this](const Request& request) { return request.cache == this; }));
+	}
+
+	if (mThread == nullptr)
+		mThread = new std::thread(&GamePresentationCache::run);
+
+	mEvent.notify_one();
+}
+
+void GamePresentationCache::run()
+{
+	while (true)
+	{
+		Request request;
+		GamePresentation::Options options;
+		int generation;
+
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+			mEvent.wait(lock, [] { return mExit || !mQueue.empty(); });
+
+			if (mExit)
+				return;
+
+			request = mQueue.front();
+			mQueue.pop_front();
+
+			options = request.cache->mOptions;
+			generation = request.cache->mGeneration;
+			mBuilding = request;
+		}
+
+		auto model = std::make_shared<GamePresentation>();
+		model->build(request.file, options, !Settings::getInstance()->getBool("LocalArt"));
+
+		{
+			std::unique_lock<std::mutex> lock(mLock);
+
+			GamePresentationCache* cache = request.cache;
+
+			// Cleared or themed again meanwhile
+			if (generation == cache->mGeneration)
+			{
+				cache->mModels[request.file] = model;
+				cache->mModelOrder.push_back(request.file);
+
+				while (cache->mModelOrder.size() > PRESENTATION_CACHE_SIZE)
+				{
+					cache->mModels.erase(cache->mModelOrder.front());
+					cache->mModelOrder.pop_front();
+				}
+			}
+
+			mBuilding = Request();
+		}
+
+		mBuilt.notify_all();
+	}
+}
+
+void GamePresentationCache::stop()
+{
+	if (mThread == nullptr)
+		return;
+
+	{
+		std::unique_lock<std::mutex> lock(mLock);
+		mExit = true;
+	}
+
+	mEvent.notify_one();
+	mThread->join();
+
+	delete mThread;
+	mThread = nullptr;
+}
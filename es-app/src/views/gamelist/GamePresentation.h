@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MetaData.h"
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FileData;
+
+// What the detailed views display for a game : resolved media paths and formatted metadata.
+// Built on a worker thread for the games the cursor is heading to, so landing on them only binds ready values
+struct GamePresentation
+{
+	// Depends on the theme of the view
+	struct Options
+	{
+		Options() : snapshotSource(-1), playersAsOne(false) { }
+
+		int snapshotSource; // ImageSource of the video snapshot, -1 without video
+		bool playersAsOne;
+		std::vector<std::vector<MetaDataId>> mdImages;
+	};
+
+	GamePresentation() : pathsResolved(false), hasManualOrMagazine(false), hasMap(false) { }
+
+	// With LocalArt, finding the media sets the metadata of the game : that part is done on the UI thread
+	bool pathsResolved;
+
+	std::string imagePath;
+	std::string thumbnailPath;
+	std::string videoPath;
+	std::string snapshotPath;
+	std::vector<std::string> mdImagePaths;
+
+	bool hasManualOrMagazine;
+	bool hasMap;
+
+	std::string name;
+	std::string description;
+	std::string rating;
+	std::string releaseDate;
+	std::string developer;
+	std::string publisher;
+	std::string genre;
+	std::string players;
+	std::string lastPlayed;
+	std::string playCount;
+	std::string gameTime;
+
+	void build(FileData* file, const Options& options, bool resolvePaths);
+	void resolvePaths(FileData* file, const Options& options);
+
+	static std::string getMdImagePath(FileData* file, const std::vector<MetaDataId>& metaDataIds);
+};
+
+class GamePresentationCache
+{
+public:
+	GamePresentationCache();
+	~GamePresentationCache();
+
+	// Drops the models built with the previous options
+	void setOptions(const GamePresentation::Options& options);
+	const GamePresentation::Options& getOptions() { return mOptions; }
+
+	// Model of the game, taken from the cache when it's ready or built now. It leaves the cache, so metadata changes are never hidden by an old model
+	std::shared_ptr<GamePresentation> take(FileData* file);
+
+	// Builds the model of the game on the worker thread
+	void request(FileData* file);
+
+	// Forgets the pending and ready models, when the list is changed
+	void clear();
+
+	// Stops the worker shared by all the caches
+	static void stop();
+
+private:
+	struct Request
+	{
+		Request() : cache(nullptr), file(nullptr) { }
+		Request(GamePresentationCache* c, FileData* f) : cache(c), file(f) { }
+
+		GamePresentationCache* cache;
+		FileData* file;
+	};
+
+	static void run();
+
+	GamePresentation::Options mOptions;
+	int						mGeneration; // incremented when the models can't be used anymore
+
+	std::map<FileData*, std::shared_ptr<GamePresentation>> mModels;
+	std::deque<FileData*>	mModelOrder; // oldest first
+
+	// One worker for the views of all the systems, guarding the models of every cache
+	static std::thread*				mThread;
+	static std::mutex				mLock;
+	static std::condition_variable	mEvent;
+	static std::condition_variable	mBuilt;
+	static bool						mExit;
+
+	static std::deque<Request>		mQueue;
+	static Request					mBuilding; // model being built by the worker, waited for instead of built twice
+};
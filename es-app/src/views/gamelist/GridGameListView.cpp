@@ -13,7 +13,7 @@
 #include "GameNameFormatter.h"
 #include "utils/Randomizer.h"
 
-GridGameListView::GridGameListView(Window* window, FolderData* root, const std::shared_ptr<ThemeData>& theme, std::string themeName, Vector2f gridSize) :
+GridGameListView::GridGameListView(Window* window, FolderData* root, const std::shared_ptr<ThemeData>& theme, std::string themeName, Vector2f gridSize, const std::vector<FileData*>* entries) :
 	ISimpleGameListView(window, root),
 	mGrid(window),
 	mDetails(this, &mGrid, mWindow, DetailedContainer::GridView)
@@ -36,7 +36,10 @@ GridGameListView::GridGameListView(Window* window, FolderData* root, const std::
 
 	setTheme(theme);
 
-	populateList(mRoot->getChildrenListToDisplay());
+	if (entries != nullptr)
+		populateList(*entries);
+	else
+		populateList(mRoot->getChildrenListToDisplay());
 	updateInfoPanel();
 }
 
@@ -217,7 +220,21 @@ void GridGameListView::populateList(const std::vector<FileData*>& files)
 			}
 		}
 
+		// Names and media paths, which may look for local files, are only resolved for the entries of the visible tiles
 		GameNameFormatter formatter(mRoot->getSystem());
+		mGrid.setEntryLoader([this, formatter](IList<ImageGridData, FileData*>::Entry& entry) mutable
+		{
+			FileData* file = entry.object;
+
+			entry.data.texturePath = getImagePath(file);
+			entry.name = formatter.getDisplayName(file, file->getType() == FOLDER && Utils::FileSystem::exists(entry.data.texturePath));
+			entry.data.videoPath = file->getVideoPath();
+			entry.data.marqueePath = file->getMarqueePath();
+			entry.data.cheevos = file->hasCheevos();
+			entry.data.virtualFolder = isVirtualFolder(file);
+		});
+
+		mGrid.reserve(mGrid.size() + (int)files.size());
 
 		bool favoritesFirst = mRoot->getSystem()->getShowFavoritesFirst();
 		if (favoritesFirst)
@@ -227,7 +244,7 @@ void GridGameListView::populateList(const std::vector<FileData*>& files)
 				if (!file->getFavorite())
 					continue;
 
-				mGrid.add(formatter.getDisplayName(file, file->getType() == FOLDER && Utils::FileSystem::exists(getImagePath(file))), getImagePath(file), file->getVideoPath(), file->getMarqueePath(), file->getFavorite(), file->hasCheevos(), file->getType() != GAME, isVirtualFolder(file), file);
+				mGrid.addUnloaded(file->getFavorite(), file->getType() != GAME, file);
 			}
 		}
 
@@ -236,7 +253,7 @@ void GridGameListView::populateList(const std::vector<FileData*>& files)
 			if (file->getFavorite() && favoritesFirst)
 				continue;
 
-			mGrid.add(formatter.getDisplayName(file, file->getType() == FOLDER && Utils::FileSystem::exists(getImagePath(file))), getImagePath(file), file->getVideoPath(), file->getMarqueePath(), file->getFavorite(), file->hasCheevos(), file->getType() != GAME, isVirtualFolder(file), file);
+			mGrid.addUnloaded(file->getFavorite(), file->getType() != GAME, file);
 		}
 
 		// if we have the ".." PLACEHOLDER, then select the first game instead of the placeholder
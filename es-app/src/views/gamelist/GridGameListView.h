@@ -14,7 +14,7 @@ class VideoComponent;
 class GridGameListView : public ISimpleGameListView
 {
 public:
-	GridGameListView(Window* window, FolderData* root, const std::shared_ptr<ThemeData>& theme, std::string customThemeName = "", Vector2f gridSize = Vector2f(0,0));
+	GridGameListView(Window* window, FolderData* root, const std::shared_ptr<ThemeData>& theme, std::string customThemeName = "", Vector2f gridSize = Vector2f(0,0), const std::vector<FileData*>* entries = nullptr);
 
 	virtual void onThemeChanged(const std::shared_ptr<ThemeData>& theme) override;
 
@@ -41,6 +41,8 @@ public:
 	virtual void setThemeName(std::string name);
 	virtual void onShow();
 	virtual std::vector<FileData*> getFileDataEntries() override;
+	virtual int getFileDataCount() override { return mGrid.size(); }
+	virtual FileData* getFileDataAt(int index) override { return mGrid.getObjectAt(index); }
 	virtual void update(int deltaTime) override;
 
 protected:
@@ -36,6 +36,9 @@ public:
 	
 	virtual std::vector<std::string> getEntriesLetters() override;
 	virtual std::vector<FileData*> getFileDataEntries() = 0;
+	// Cheap access to the entries, without copying them all
+	virtual int getFileDataCount() = 0;
+	virtual FileData* getFileDataAt(int index) = 0;
 
 	void	moveToFolder(FolderData* folder);
 	FolderData*		getCurrentFolder();
@@ -0,0 +1,147 @@
+#include "views/gamelist/MediaPrefetcher.h"
+
+#include "resources/TextureResource.h"
+#include "views/gamelist/ISimpleGameListView.h"
+#include "FileData.h"
+#include "Settings.h"
+
+#include <SDL_timer.h>
+#include <algorithm>
+#include <cstdlib>
+
+// Time a texture takes to load : the look-ahead covers the entries the cursor goes through meanwhile
+#define PREFETCH_LEAD_TIME	0.25f
+// Above this delay between two moves, the cursor was stopped
+#define PREFETCH_IDLE_TIME	500
+
+MediaPrefetcher::Statistics MediaPrefetcher::sStatistics;
+
+MediaPrefetcher::MediaPrefetcher(const MediaResolver& resolver) : mResolver(resolver), mDirection(0), mLastMoveTime(0), mVelocity(0.0f)
+{
+}
+
+MediaPrefetcher::~MediaPrefetcher()
+{
+	clear();
+}
+
+bool MediaPrefetcher::isLoaded(const Entry& entry)
+{
+	for (auto& texture : entry.textures)
+		if (!texture->isLoaded())
+			return false;
+
+	return true;
+}
+
+void MediaPrefetcher::cancel(Entry& entry)
+{
+	if (!isLoaded(entry))
+		sStatistics.cancelled++;
+
+	for (auto& texture : entry.textures)
+		TextureResource::cancelAsync(texture);
+
+	entry.textures.clear();
+}
+
+void MediaPrefetcher::clear()
+{
+	for (auto& entry : mEntries)
+		cancel(entry);
+
+	mEntries.clear();
+}
+
+void MediaPrefetcher::onCursorChanged(ISimpleGameListView* view, FileData* file, int moveBy)
+{
+	int maxCount = Settings::getInstance()->getInt("GamelistPrefetch");
+	if (maxCount <= 0 || view == nullptr || file == nullptr)
+	{
+		clear();
+		return;
+	}
+
+	auto landed = std::find_if(mEntries.begin(), mEntries.end(), [file](const Entry& entry) { return entry.file == file; });
+	if (landed != mEntries.end())
+	{
+		if (isLoaded(*landed))
+			sStatistics.hits++;
+		else
+			sStatistics.late++;
+
+		// Its textures are the ones of the displayed images now : they must not be cancelled
+		mEntries.erase(landed);
+	}
+	else if (moveBy != 0 && file->getType() == GAME)
+		sStatistics.misses++;
+
+	int count = view->getFileDataCount();
+	if (moveBy == 0 || count < 2)
+		return;
+
+	// The cursor looped from an end of the list to the other
+	if (std::abs(moveBy) > count / 2)
+		moveBy += (moveBy > 0 ? -count : count);
+
+	if (moveBy == 0)
+		return;
+
+	int direction = (moveBy > 0 ? 1 : -1);
+
+	int now = SDL_GetTicks();
+	int elapsed = now - mLastMoveTime;
+	mLastMoveTime = now;
+
+	if (direction != mDirection || elapsed > PREFETCH_IDLE_TIME)
+		mVelocity = 0.0f;
+	else
+		mVelocity = (mVelocity + std::abs(moveBy) * 1000.0f / std::max(1, elapsed)) / 2.0f;
+
+	// Turning back : everything that was loading is behind the cursor now
+	if (direction != mDirection)
+		clear();
+
+	mDirection = direction;
+
+	// Pages are skipped by pages
+	int stride = std::abs(moveBy);
+	int lookAhead = std::min(maxCount, 1 + (int)(mVelocity * PREFETCH_LEAD_TIME));
+	int cursor = view->getCursorIndex();
+
+	std::vector<Entry> entries;
+
+	for (int i = 1; i <= lookAhead && i * stride < count; i++)
+	{
+		int index = (cursor + direction * stride * i) % count;
+		if (index < 0)
+			index += count;
+
+		FileData* next = view->getFileDataAt(index);
+		if (next == nullptr || next->getType() != GAME)
+			continue;
+
+		auto it = std::find_if(mEntries.begin(), mEntries.end(), [next](const Entry& entry) { return entry.file == next; });
+		if (it != mEntries.end())
+		{
+			entries.push_back(*it);
+			mEntries.erase(it);
+			continue;
+		}
+
+		// Nearest games are queued first
+		Entry entry;
+		entry.file = next;
+		mResolver(next, entry.textures);
+
+		if (entry.textures.size() == 0)
+			continue;
+
+		sStatistics.requested++;
+		entries.push_back(entry);
+	}
+
+	// Passed by the cursor, or out of the look-ahead
+	clear();
+	mEntries = entries;
+}
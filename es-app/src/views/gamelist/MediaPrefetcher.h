@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+class FileData;
+class ISimpleGameListView;
+class TextureResource;
+
+// Loads the artwork of the games the cursor is heading to, so it's ready when the cursor lands on them.
+// The look-ahead follows the direction and the speed of the cursor. When the direction changes, pending loads are cancelled.
+class MediaPrefetcher
+{
+public:
+	// Fills the textures a game will display, created with prefetchImage
+	typedef std::function<void(FileData* file, std::vector<std::shared_ptr<TextureResource>>& textures)> MediaResolver;
+
+	struct Statistics
+	{
+		Statistics() : requested(0), hits(0), late(0), misses(0), cancelled(0) { }
+
+		unsigned int requested; // games prefetched
+		unsigned int hits;      // cursor landed on a prefetched game, with its artwork loaded
+		unsigned int late;      // cursor landed on a prefetched game, still loading
+		unsigned int misses;    // cursor landed on a game that was not predicted
+		unsigned int cancelled; // prefetched games dropped before being loaded
+	};
+
+	MediaPrefetcher(const MediaResolver& resolver);
+	~MediaPrefetcher();
+
+	// The cursor of the view landed on file, moveBy entries away from the previous one
+	void onCursorChanged(ISimpleGameListView* view, FileData* file, int moveBy);
+	void clear();
+
+	// Totals of all the gamelists
+	static const Statistics& getStatistics() { return sStatistics; }
+
+private:
+	struct Entry
+	{
+		FileData* file;
+		std::vector<std::shared_ptr<TextureResource>> textures;
+	};
+
+	static bool isLoaded(const Entry& entry);
+	void cancel(Entry& entry);
+
+	MediaResolver		mResolver;
+	std::vector<Entry>	mEntries;
+
+	int		mDirection;
+	int		mLastMoveTime;
+	float	mVelocity; // entries per second
+
+	static Statistics sStatistics;
+};
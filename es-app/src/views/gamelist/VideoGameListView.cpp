@@ -7,8 +7,8 @@
 #include "views/ViewController.h"
 #include "LangParser.h"
 
-VideoGameListView::VideoGameListView(Window* window, FolderData* root) :
-	BasicGameListView(window, root),
+VideoGameListView::VideoGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries) :
+	BasicGameListView(window, root, entries),
 	mDetails(this, &mList, mWindow, DetailedContainer::VideoView)
 {
 	// Let DetailedContainer handle extras with activation scripts
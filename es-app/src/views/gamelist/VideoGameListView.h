@@ -12,7 +12,7 @@ class VideoComponent;
 class VideoGameListView : public BasicGameListView
 {
 public:
-	VideoGameListView(Window* window, FolderData* root);
+	VideoGameListView(Window* window, FolderData* root, const std::vector<FileData*>* entries = nullptr);
 
 	virtual void onShow() override;
 
@@ -7,17 +7,22 @@
 #include "ThemeData.h"
 #include "Window.h"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include "animations/LambdaAnimation.h"
 #include "anim/StoryboardAnimator.h"
 #include "components/ScrollableContainer.h"
 #include "math/Vector2i.h"
 
 bool GuiComponent::isLaunchTransitionRunning = false;
+std::atomic<bool> GuiComponent::sInvalidated(true);
+std::atomic<unsigned int> GuiComponent::sBitmapCacheGeneration(0);
 
 GuiComponent::GuiComponent(Window* window) : mWindow(window), mParent(NULL), mOpacity(255),
 	mPosition(Vector3f::Zero()), mOrigin(Vector2f::Zero()), mRotationOrigin(0.5, 0.5), mScaleOrigin(0.5f, 0.5f),
-	mSize(Vector2f::Zero()), mTransform(Transform4x4f::Identity()), mIsProcessing(false), mVisible(true), mShowing(false),
-	mStaticExtra(false), mStoryboardAnimator(nullptr), mScreenOffset(0.0f)
+	mSize(Vector2f::Zero()), mTransformDirty(true), mTransform(Transform4x4f::Identity()), mWorldTransformDirty(true), mIsProcessing(false), mVisible(true), mShowing(false),
+	mStaticExtra(false), mStoryboardAnimator(nullptr), mScreenOffset(0.0f),
+	mCacheAsBitmap(false), mBitmapCacheDirty(true), mBitmapCache(0), mBitmapCacheGeneration(0)
 {
 	mClipRect = Vector4f();
 }
@@ -27,6 +32,7 @@ GuiComponent::~GuiComponent()
 	mWindow->removeGui(this);
 
 	cancelAllAnimations();
+	destroyBitmapCache();
 
 	if (mStoryboardAnimator != nullptr)
 	{
@@ -56,6 +62,8 @@ void GuiComponent::updateSelf(int deltaTime)
 {
 	if (mAnimationMap.size())
 	{
+		invalidatePlacement();
+
 		for (auto it = mAnimationMap.cbegin(), next_it = it; it != mAnimationMap.cend(); it = next_it)
 		{
 			++next_it;
@@ -63,8 +71,12 @@ void GuiComponent::updateSelf(int deltaTime)
 		}
 	}
 
-	if (mStoryboardAnimator != nullptr)
+	if (mStoryboardAnimator != nullptr && mStoryboardAnimator->isRunning())
+	{
+		// Storyboards can animate any property
+		invalidateContent();
 		mStoryboardAnimator->update(deltaTime);
+	}
 }
 
 void GuiComponent::updateChildren(int deltaTime)
@@ -87,9 +99,10 @@ void GuiComponent::render(const Transform4x4f& parentTrans)
 	if (mChildren.empty() || !mVisible)
 		return;
 
-	Transform4x4f trans = parentTrans * getTransform();
+	Transform4x4f trans = getWorldTransform(parentTrans);
 
-	if (!Renderer::isVisibleOnScreen(trans.translation().x(), trans.translation().y(), mSize.x(), mSize.y()))
+	// Offscreen : the whole subtree is skipped
+	if (!isVisibleOnScreen())
 		return;
 	
 	if (!mClipRect.empty() && !GuiComponent::isLaunchTransitionRunning)
@@ -104,7 +117,7 @@ void GuiComponent::render(const Transform4x4f& parentTrans)
 void GuiComponent::renderChildren(const Transform4x4f& transform) const
 {
 	for (auto child : mChildren)
-		TRYCATCH("GuiComponent::renderChildren", child->render(transform));
+		TRYCATCH("GuiComponent::renderChildren", child->renderCached(transform));
 }
 
 Vector3f GuiComponent::getPosition() const
@@ -114,6 +127,9 @@ Vector3f GuiComponent::getPosition() const
 
 void GuiComponent::setPosition(float x, float y, float z)
 {
+	if (mPosition.x() != x || mPosition.y() != y || mPosition.z() != z)
+		invalidatePlacement();
+
 	mPosition = Vector3f(x, y, z);
 	onPositionChanged();
 }
@@ -125,6 +141,9 @@ Vector2f GuiComponent::getOrigin() const
 
 void GuiComponent::setOrigin(float x, float y)
 {
+	if (mOrigin.x() != x || mOrigin.y() != y)
+		invalidatePlacement();
+
 	mOrigin = Vector2f(x, y);
 	onOriginChanged();
 }
@@ -136,6 +155,9 @@ Vector2f GuiComponent::getRotationOrigin() const
 
 void GuiComponent::setRotationOrigin(float x, float y)
 {
+	if (mRotationOrigin.x() != x || mRotationOrigin.y() != y)
+		invalidatePlacement();
+
 	mRotationOrigin = Vector2f(x, y);
 }
 
@@ -146,6 +168,9 @@ Vector2f GuiComponent::getSize() const
 
 void GuiComponent::setSize(float w, float h)
 {
+	if (mSize.x() != w || mSize.y() != h)
+		invalidateContent();
+
 	mSize = Vector2f(w, h);
     onSizeChanged();
 }
@@ -157,6 +182,9 @@ float GuiComponent::getRotation() const
 
 void GuiComponent::setRotation(float rotation)
 {
+	if (mRotation != rotation)
+		invalidatePlacement();
+
 	mRotation = rotation;
 }
 
@@ -167,6 +195,9 @@ float GuiComponent::getScale() const
 
 void GuiComponent::setScale(float scale)
 {
+	if (mScale != scale)
+		invalidatePlacement();
+
 	mScale = scale;
 }
 
@@ -177,6 +208,9 @@ Vector2f GuiComponent::getScaleOrigin() const
 
 void GuiComponent::setScaleOrigin(const Vector2f& scaleOrigin)
 {
+	if (mScaleOrigin != scaleOrigin)
+		invalidatePlacement();
+
 	mScaleOrigin = scaleOrigin;
 }
 
@@ -187,6 +221,9 @@ float GuiComponent::getZIndex() const
 
 void GuiComponent::setZIndex(float z)
 {
+	if (mZIndex != z)
+		invalidatePlacement();
+
 	mZIndex = z;
 }
 
@@ -206,6 +243,9 @@ bool GuiComponent::isVisible() const
 }
 void GuiComponent::setVisible(bool visible)
 {
+	if (mVisible != visible)
+		invalidatePlacement();
+
 	mVisible = visible;
 }
 
@@ -218,6 +258,7 @@ Vector2f GuiComponent::getCenter() const
 //Children stuff.
 void GuiComponent::addChild(GuiComponent* cmp)
 {
+	invalidateContent();
 	mChildren.push_back(cmp);
 
 	if(cmp->getParent())
@@ -237,6 +278,7 @@ void GuiComponent::removeChild(GuiComponent* cmp)
 	}
 
 	cmp->setParent(NULL);
+	invalidateContent();
 
 	for(auto i = mChildren.cbegin(); i != mChildren.cend(); i++)
 	{
@@ -250,6 +292,7 @@ void GuiComponent::removeChild(GuiComponent* cmp)
 
 void GuiComponent::clearChildren()
 {
+	invalidateContent();
 	mChildren.clear();
 }
 
@@ -291,14 +334,251 @@ void GuiComponent::setOpacity(unsigned char opacity)
 		return;
 
 	mOpacity = opacity;
+
+	// Applied to the cached picture : the children keep drawing opaque
+	if (mCacheAsBitmap)
+	{
+		invalidate();
+		return;
+	}
+
+	invalidatePlacement();
+
 	for(auto it = mChildren.cbegin(); it != mChildren.cend(); it++)
 	{
 		(*it)->setOpacity(opacity);
 	}
 }
 
+void GuiComponent::invalidateContent()
+{
+	invalidate();
+
+	// mSize is often written directly along with the content
+	mTransformDirty = true;
+
+	for (GuiComponent* cmp = this; cmp != nullptr; cmp = cmp->mParent)
+		cmp->mBitmapCacheDirty = true;
+}
+
+void GuiComponent::invalidatePlacement()
+{
+	mTransformDirty = true;
+
+	if (mParent != nullptr)
+		mParent->invalidateContent();
+	else
+		invalidate();
+}
+
+void GuiComponent::setCacheAsBitmap(bool cache)
+{
+	cache = cache && Renderer::isRenderTargetSupported();
+	if (mCacheAsBitmap == cache)
+		return;
+
+	const unsigned char opacity = mOpacity;
+
+	if (cache)
+	{
+		// The children were given the opacity of the component : it will be applied to the picture instead
+		if (opacity != 255)
+			setOpacity(255);
+
+		mCacheAsBitmap = true;
+		mOpacity = opacity;
+	}
+	else
+	{
+		destroyBitmapCache();
+		mCacheAsBitmap = false;
+
+		if (opacity != 255)
+		{
+			mOpacity = 255;
+			setOpacity(opacity);
+		}
+	}
+
+	invalidateContent();
+}
+
+void GuiComponent::destroyBitmapCache()
+{
+	if (mBitmapCache == 0)
+		return;
+
+	Renderer::destroyRenderTarget(mBitmapCache);
+	mBitmapCache = 0;
+	mBitmapCacheDirty = true;
+}
+
+Vector4f GuiComponent::getBitmapCacheBounds()
+{
+	const Vector2f size = getSize();
+
+	float x0 = 0, y0 = 0;
+	float x1 = size.x(), y1 = size.y();
+
+	// Children drawn around the component (backgrounds, shadows...) are kept, within a margin
+	for (auto child : mChildren)
+	{
+		if (!child->isVisible())
+			continue;
+
+		const Transform4x4f& trans = child->getTransform();
+		const Vector2f childSize = child->getSize();
+
+		const float cx0 = trans.r0().x() * childSize.x();
+		const float cy0 = trans.r0().y() * childSize.x();
+		const float cx1 = trans.r1().x() * childSize.y();
+		const float cy1 = trans.r1().y() * childSize.y();
+
+		const float x = trans.translation().x() + Math::min(cx0, 0.0f) + Math::min(cx1, 0.0f);
+		const float y = trans.translation().y() + Math::min(cy0, 0.0f) + Math::min(cy1, 0.0f);
+
+		x0 = Math::min(x0, x);
+		y0 = Math::min(y0, y);
+		x1 = Math::max(x1, x + std::abs(cx0) + std::abs(cx1));
+		y1 = Math::max(y1, y + std::abs(cy0) + std::abs(cy1));
+	}
+
+	const float margin = Renderer::getScreenHeight() * 0.05f;
+
+	x0 = std::floor(Math::max(x0, -margin));
+	y0 = std::floor(Math::max(y0, -margin));
+	x1 = std::ceil(Math::min(x1, size.x() + margin));
+	y1 = std::ceil(Math::min(y1, size.y() + margin));
+
+	return Vector4f(x0, y0, x1 - x0, y1 - y0);
+}
+
+void GuiComponent::renderCached(const Transform4x4f& parentTrans)
+{
+	if (!mCacheAsBitmap || !mVisible)
+	{
+		render(parentTrans);
+		return;
+	}
+
+	if (mOpacity == 0)
+		return;
+
+	// The picture is drawn in local coordinates : the transform of the component has to be undone
+	if (mScale == 0.0f)
+	{
+		render(parentTrans);
+		return;
+	}
+
+	Transform4x4f inverse = Transform4x4f::Identity();
+	inverse.invert(getTransform());
+
+	const Vector4f bounds = getBitmapCacheBounds();
+	const int width = (int)bounds.z();
+	const int height = (int)bounds.w();
+
+	if (width <= 0 || height <= 0)
+		return;
+
+	// Lost with the renderer, or resized
+	if (mBitmapCache != 0 && (Renderer::getRenderTargetTexture(mBitmapCache) == 0 || (int)mBitmapCacheBounds.z() != width || (int)mBitmapCacheBounds.w() != height))
+		destroyBitmapCache();
+
+	if (mBitmapCache == 0)
+	{
+		mBitmapCache = Renderer::createRenderTarget(width, height);
+		mBitmapCacheDirty = true;
+
+		if (mBitmapCache == 0)
+		{
+			render(parentTrans);
+			return;
+		}
+	}
+
+	if (mBitmapCacheDirty || mBitmapCacheGeneration != sBitmapCacheGeneration || mBitmapCacheBounds != bounds)
+	{
+		mBitmapCacheGeneration = sBitmapCacheGeneration;
+		mBitmapCacheBounds = bounds;
+
+		if (!Renderer::pushRenderTarget(mBitmapCache, width, height))
+		{
+			destroyBitmapCache();
+			render(parentTrans);
+			return;
+		}
+
+		const unsigned char opacity = mOpacity;
+		mOpacity = 255;
+
+		Transform4x4f origin = Transform4x4f::Identity();
+		origin.translate(Vector3f(-bounds.x(), -bounds.y(), 0.0f));
+		render(origin * inverse);
+
+		mOpacity = opacity;
+		mBitmapCacheDirty = false;
+
+		Renderer::popRenderTarget();
+	}
+
+	// Render targets are upside down, and their pixels have premultiplied alpha
+	const unsigned int color = Renderer::convertColor((mOpacity << 24) | (mOpacity << 16) | (mOpacity << 8) | mOpacity);
+	const float x = bounds.x(), y = bounds.y(), w = bounds.z(), h = bounds.w();
+
+	Renderer::Vertex vertices[4];
+	vertices[0] = { { x    , y     }, { 0.0f, 1.0f }, color };
+	vertices[1] = { { x    , y + h }, { 0.0f, 0.0f }, color };
+	vertices[2] = { { x + w, y     }, { 1.0f, 1.0f }, color };
+	vertices[3] = { { x + w, y + h }, { 1.0f, 0.0f }, color };
+
+	Renderer::setMatrix(getWorldTransform(parentTrans));
+	Renderer::bindTexture(Renderer::getRenderTargetTexture(mBitmapCache));
+	Renderer::drawTriangleStrips(&vertices[0], 4, Renderer::Blend::ONE, Renderer::Blend::ONE_MINUS_SRC_ALPHA);
+}
+
+const Transform4x4f& GuiComponent::getWorldTransform(const Transform4x4f& parentTrans)
+{
+	const Transform4x4f& local = getTransform();
+
+	if (!mWorldTransformDirty && memcmp(&parentTrans, &mParentTransform, sizeof(Transform4x4f)) == 0)
+		return mWorldTransform;
+
+	mWorldTransformDirty = false;
+	mParentTransform = parentTrans;
+	mWorldTransform = parentTrans * local;
+
+	const Vector3f& pos = mWorldTransform.translation();
+
+	float x0 = mWorldTransform.r0().x() * mSize.x();
+	float y0 = mWorldTransform.r0().y() * mSize.x();
+	float x1 = mWorldTransform.r1().x() * mSize.y();
+	float y1 = mWorldTransform.r1().y() * mSize.y();
+
+	mWorldBounds = Vector4f(
+		pos.x() + Math::min(x0, 0.0f) + Math::min(x1, 0.0f),
+		pos.y() + Math::min(y0, 0.0f) + Math::min(y1, 0.0f),
+		std::abs(x0) + std::abs(x1),
+		std::abs(y0) + std::abs(y1));
+
+	return mWorldTransform;
+}
+
+bool GuiComponent::isVisibleOnScreen() const
+{
+	return Renderer::isVisibleOnScreen(mWorldBounds.x(), mWorldBounds.y(), mWorldBounds.z(), mWorldBounds.w());
+}
+
 const Transform4x4f& GuiComponent::getTransform()
 {
+	if (!mTransformDirty)
+		return mTransform;
+
+	mTransformDirty = false;
+	mWorldTransformDirty = true;
+
+	Vector2f rotationSize = mRotation != 0.0 ? getRotationSize() : Vector2f::Zero();
+
 	mTransform = Transform4x4f::Identity();
 	mTransform.translate(mPosition);
 
@@ -322,7 +602,6 @@ const Transform4x4f& GuiComponent::getTransform()
 	if (mRotation != 0.0)
 	{
 		// Calculate offset as difference between origin and rotation origin
-		Vector2f rotationSize = getRotationSize();
 		float xOff = (mOrigin.x() - mRotationOrigin.x()) * rotationSize.x();
 		float yOff = (mOrigin.y() - mRotationOrigin.y()) * rotationSize.y();
 
@@ -664,18 +943,21 @@ void GuiComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std
 	{
 		Vector2f denormalized = elem->get<Vector2f>("offset") * screenScale;
 		mScreenOffset = denormalized;
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("offsetX"))
 	{
 		float denormalized = elem->get<float>("offsetX") * screenScale.x();
 		mScreenOffset = Vector2f(denormalized, mScreenOffset.y());
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("offsetY"))
 	{
 		float denormalized = elem->get<float>("offsetY") * scale.y();
 		mScreenOffset = Vector2f(mScreenOffset.x(), denormalized);
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("clipRect"))
@@ -686,6 +968,9 @@ void GuiComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const std
 	else
 		setClipRect(Vector4f());
 
+	if (elem->has("cacheAsBitmap"))
+		setCacheAsBitmap(elem->get<bool>("cacheAsBitmap"));
+
 	applyStoryboard(elem);
 }
 
@@ -764,6 +1049,7 @@ void GuiComponent::topWindow(bool isTop)
 void GuiComponent::animateTo(Vector2f from, Vector2f to, unsigned int  flags, int delay)
 {
 	mScaleOrigin = Vector2f::Zero();
+	mTransformDirty = true; // mScale is animated directly : the animation invalidates the placement every frame
 
 	if ((flags & AnimateFlags::POSITION)==0)
 		from = to;
@@ -950,13 +1236,22 @@ void GuiComponent::setProperty(const std::string name, const ThemeData::ThemeEle
 		setScaleOrigin(Vector2f(value.v.x(), value.v.y()));
 
 	if (name == "offset" && value.type == ThemeData::ThemeElement::Property::PropertyType::Pair)
+	{
 		mScreenOffset = Vector2f(value.v.x() * screenScale.x(), value.v.y() * screenScale.y());
+		mTransformDirty = true;
+	}
 	
 	if (name == "offsetX" && value.type == ThemeData::ThemeElement::Property::PropertyType::Float)
+	{
 		mScreenOffset = Vector2f(value.f * screenScale.x(), mScreenOffset.y());
+		mTransformDirty = true;
+	}
 
 	if (name == "offsetY" && value.type == ThemeData::ThemeElement::Property::PropertyType::Float)
+	{
 		mScreenOffset = Vector2f(mScreenOffset.x(), value.f * screenScale.y());
+		mTransformDirty = true;
+	}
 
 	if (name == "clipRect" && value.type == ThemeData::ThemeElement::Property::PropertyType::Rect)
 		setClipRect(Vector4f(value.r.x() * screenScale.x(), value.r.y() * screenScale.y(), value.r.z() * screenScale.x(), value.r.w() * screenScale.y()));
@@ -7,6 +7,7 @@
 #include "HelpPrompt.h"
 #include "HelpStyle.h"
 #include "InputConfig.h"
+#include <atomic>
 #include <functional>
 #include "ThemeData.h"
 #include <memory>
@@ -129,6 +130,8 @@ public:
 	virtual void setOpacity(unsigned char opacity);
 
 	const Transform4x4f& getTransform();
+	const Transform4x4f& getWorldTransform(const Transform4x4f& parentTrans); // parentTrans * getTransform(), kept until one of them changes
+	bool isVisibleOnScreen() const; // Screen bounds of the last world transform
 
 	virtual std::string getValue() const;
 	virtual void setValue(const std::string& value);
@@ -191,7 +194,21 @@ public:
 	Vector4f& getClipRect() { return mClipRect; }
 	virtual void setClipRect(const Vector4f& vec);
 
+	// Bitmap caching : the component and its children are drawn once to a render target, then displayed as a single quad.
+	// The picture is drawn again only when the content of the component or of one of its children is invalidated
+	void setCacheAsBitmap(bool cache);
+	bool isCacheAsBitmap() const { return mCacheAsBitmap; }
+
+	// Same as render, through the bitmap cache if the component has one
+	void renderCached(const Transform4x4f& parentTrans);
+
+	// What the component displays changed : invalidates the screen and the bitmap caches containing the component
+	void invalidateContent();
+
 protected:
+	// Rect (x, y, w, h) in local coordinates of what is kept in the bitmap cache
+	virtual Vector4f getBitmapCacheBounds();
+
 	void beginCustomClipRect();
 	void endCustomClipRect();
 
@@ -215,6 +232,9 @@ protected:
 
 	float mRotation = 0.0;
 	float mScale = 1.0;
+
+	// Set by the setters : components writing mPosition, mSize... directly have to set it too
+	bool mTransformDirty;
 	float mDefaultZIndex = 0;
 	float mZIndex = 0;
 
@@ -227,8 +247,34 @@ public:
 	const static unsigned char MAX_ANIMATIONS = 4;
 	static bool isLaunchTransitionRunning;
 
+	// Damage tracking : anything that changes what is displayed must invalidate the screen, so the window can skip identical frames.
+	// Can be called from any thread (texture loaders...)
+	static void invalidate() { sInvalidated = true; }
+	// Returns true if the screen was invalidated since the last call
+	static bool validate() { return sInvalidated.exchange(false); }
+	// Draws all the bitmap caches again, for changes the components can't track (texture loads, input...). Can be called from any thread
+	static void invalidateBitmapCaches() { sBitmapCacheGeneration++; invalidate(); }
+
 private:
+	static std::atomic<bool> sInvalidated;
+	static std::atomic<unsigned int> sBitmapCacheGeneration;
+
+	// The component moved or was hidden : the caches of its parents are affected, not its own
+	void invalidatePlacement();
+	void destroyBitmapCache();
+
+	bool         mCacheAsBitmap;
+	bool         mBitmapCacheDirty;
+	unsigned int mBitmapCache; // Render target
+	unsigned int mBitmapCacheGeneration;
+	Vector4f     mBitmapCacheBounds;
+
 	Transform4x4f mTransform; //Don't access this directly! Use getTransform()!
+
+	Transform4x4f mParentTransform; // mWorldTransform was built from
+	Transform4x4f mWorldTransform;
+	Vector4f mWorldBounds; // Screen bounding box (x, y, w, h), scaled and rotated corners included
+	bool mWorldTransformDirty;
 	Vector4f mClipRect;
 
 	std::map<unsigned char, AnimationController*> mAnimationMap;
@@ -8,7 +8,11 @@
 #include <sstream>
 #include <fstream>
 #include <map>
+#include <unordered_map>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <nanosvg/nanosvg.h>
 #include "renderers/Renderer.h"
 
 unsigned char* ImageIO::loadFromMemoryRGBA32(const unsigned char * data, const size_t size, size_t & width, size_t & height, MaxSizeInfo* maxSize, Vector2i* baseSize, Vector2i* packedSize)
@@ -212,131 +216,218 @@ struct CachedFileInfo
 	int y;	
 };
 
-static std::map<std::string, CachedFileInfo> sizeCache;
-static bool sizeCacheDirty = false;
+// Binary cache file : a header followed by records appended one after the other.
+// A record for a path that is already known replaces the previous one, a record with a negative size removes it.
+//   header : "ESIC" + uint32 version
+//   record : uint16 pathLength + path + int32 size + int32 x + int32 y
+#define IMAGECACHE_MAGIC	"ESIC"
+#define IMAGECACHE_VERSION	1
 
-std::string getImageCacheFilename()
+static std::unordered_map<std::string, CachedFileInfo> sizeCache;
+static std::mutex sizeCacheLock;
+
+static std::vector<std::string> sizeCachePending; // Paths to append to the cache file on next save
+static size_t sizeCacheFileRecords = 0;
+static bool sizeCacheRewrite = true;
+
+static std::thread* sizeCacheBuilder = nullptr;
+static std::atomic<bool> sizeCacheBuilderExit(false);
+
+static std::string getImageCacheFilename()
 {
-	return Utils::FileSystem::getEsConfigPath() + "/imagecache.db";
+	return Utils::FileSystem::getEsConfigPath() + "/imagecache.bin";
+}
+
+static std::string getImageCacheRelativeTo()
+{
+#if WIN32
+	return Utils::FileSystem::getParent(Utils::FileSystem::getHomePath());
+#else
+	return "/userdata";
+#endif
+}
+
+static bool _isCachablePath(const std::string& path)
+{
+	return 
+		path.find("/themes/") == std::string::npos && 
+		path.find("/tmp/") == std::string::npos &&
+		path.find("/emulationstation.tmp/") == std::string::npos &&
+		path.find("/pdftmp/") == std::string::npos && 
+		path.find("/saves/") == std::string::npos;
+}
+
+static void writeImageCacheRecord(FILE* file, const std::string& path, const CachedFileInfo& info, const std::string& relativeTo)
+{
+	std::string relative = Utils::FileSystem::createRelativePath(path, relativeTo, true);
+	if (relative.size() > 0xFFFF)
+		return;
+
+	uint16_t len = (uint16_t)relative.size();
+	int32_t values[3] = { info.size, info.x, info.y };
+
+	fwrite(&len, sizeof(len), 1, file);
+	fwrite(relative.c_str(), 1, len, file);
+	fwrite(values, sizeof(int32_t), 3, file);
 }
 
 void ImageIO::clearImageCache()
 {
-	std::string fname = getImageCacheFilename();
-	Utils::FileSystem::removeFile(fname);
+	stopImageCacheBuild();
+
+	std::unique_lock<std::mutex> lock(sizeCacheLock);
+
+	Utils::FileSystem::removeFile(getImageCacheFilename());
 	sizeCache.clear();
+	sizeCachePending.clear();
+	sizeCacheFileRecords = 0;
+	sizeCacheRewrite = true;
 }
 
 void ImageIO::loadImageCache()
 {
+	std::unique_lock<std::mutex> lock(sizeCacheLock);
+
+	sizeCache.clear();
+	sizeCachePending.clear();
+	sizeCacheFileRecords = 0;
+	sizeCacheRewrite = true;
+
+	// Text cache used by previous versions
+	std::string legacyFile = Utils::FileSystem::getEsConfigPath() + "/imagecache.db";
+	if (Utils::FileSystem::exists(legacyFile))
+		Utils::FileSystem::removeFile(legacyFile);
+
 	std::string fname = getImageCacheFilename();
 
-	std::ifstream f(fname.c_str());
-	if (f.fail())
+	FILE* file = fopen(fname.c_str(), "rb");
+	if (file == nullptr)
 		return;
 
-	sizeCache.clear();
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
 
-#if WIN32
-	std::string relativeTo = Utils::FileSystem::getParent(Utils::FileSystem::getHomePath());
-#else
-	std::string relativeTo = "/userdata";	
-#endif
+	// Read the whole file at once, records are then parsed from memory
+	std::vector<unsigned char> buffer(length > 0 ? length : 0);
+	size_t read = length > 0 ? fread(buffer.data(), 1, length, file) : 0;
+	fclose(file);
 
-	std::vector<std::string> splits;
+	const size_t headerSize = 4 + sizeof(uint32_t);
+	if (read < headerSize || memcmp(buffer.data(), IMAGECACHE_MAGIC, 4) != 0)
+		return;
 
-	std::string line;
-	while (std::getline(f, line))
-	{
-		splits.clear();
+	uint32_t version;
+	memcpy(&version, buffer.data() + 4, sizeof(uint32_t));
+	if (version != IMAGECACHE_VERSION)
+		return;
 
-		const char* src = line.c_str();
+	std::string relativeTo = getImageCacheRelativeTo();
 
-		while (true)
-		{
-			const char* d = strchr(src, '|');
-			size_t len = (d) ? d - src : strlen(src);
+	size_t pos = headerSize;
+	while (pos + sizeof(uint16_t) <= read)
+	{
+		uint16_t len;
+		memcpy(&len, buffer.data() + pos, sizeof(uint16_t));
 
-			if (len)
-				splits.push_back(std::string(src, len)); // capture token
+		// Ignore a truncated record at the end of the file
+		if (pos + sizeof(uint16_t) + len + 3 * sizeof(int32_t) > read)
+			break;
 
-			if (d) src += len + 1; else break;
-		}
+		pos += sizeof(uint16_t);
+		std::string path((const char*)buffer.data() + pos, len);
+		pos += len;
 
-		if (splits.size() == 4)
-		{
-			std::string file = Utils::FileSystem::resolveRelativePath(splits[0], relativeTo, true);
+		int32_t values[3];
+		memcpy(values, buffer.data() + pos, 3 * sizeof(int32_t));
+		pos += 3 * sizeof(int32_t);
 
-			CachedFileInfo fi;
-			fi.size = Utils::String::toInteger(splits[1]);
-			fi.x = Utils::String::toInteger(splits[2]);
-			fi.y = Utils::String::toInteger(splits[3]);
+		sizeCacheFileRecords++;
 
-			sizeCache[file] = fi;
-		}
+		std::string file = Utils::FileSystem::resolveRelativePath(path, relativeTo, true);
+		if (values[0] < 0)
+			sizeCache.erase(file);
+		else
+			sizeCache[file] = CachedFileInfo(values[0], values[1], values[2]);
 	}
 
-	f.close();
-}
-
-static bool _isCachablePath(const std::string& path)
-{
-	return 
-		path.find("/themes/") == std::string::npos && 
-		path.find("/tmp/") != std::string::npos &&
-		path.find("/emulationstation.tmp/") != std::string::npos &&
-		path.find("/pdftmp/") == std::string::npos && 
-		path.find("/saves/") != std::string::npos;
+	// Records can be appended until the file contains too many obsolete ones
+	sizeCacheRewrite = sizeCacheFileRecords > sizeCache.size() * 2 + 64;
 }
 
 void ImageIO::saveImageCache()
 {
-	if (!sizeCacheDirty)
+	stopImageCacheBuild();
+
+	std::unique_lock<std::mutex> lock(sizeCacheLock);
+
+	if (sizeCachePending.size() == 0 && !sizeCacheRewrite)
 		return;
 
 	std::string fname = getImageCacheFilename();
-	std::ofstream f(fname.c_str(), std::ios::binary);
-	if (f.fail())
-		return;
+	std::string relativeTo = getImageCacheRelativeTo();
 
-#if WIN32
-	std::string relativeTo = Utils::FileSystem::getParent(Utils::FileSystem::getHomePath());
-#else
-	std::string relativeTo = "/userdata";
-#endif
+	if (sizeCacheRewrite || !Utils::FileSystem::exists(fname))
+	{
+		FILE* file = fopen(fname.c_str(), "wb");
+		if (file == nullptr)
+			return;
+
+		uint32_t version = IMAGECACHE_VERSION;
+		fwrite(IMAGECACHE_MAGIC, 1, 4, file);
+		fwrite(&version, sizeof(uint32_t), 1, file);
 
-	for (auto it : sizeCache)
+		sizeCacheFileRecords = 0;
+
+		for (auto it : sizeCache)
+		{
+			if (it.second.size < 0 || !_isCachablePath(it.first))
+				continue;
+
+			writeImageCacheRecord(file, it.first, it.second, relativeTo);
+			sizeCacheFileRecords++;
+		}
+
+		fclose(file);
+	}
+	else
 	{
-		if (it.second.size < 0)
-			continue;
-
-		if (!_isCachablePath(it.first))
-			continue;
-
-		std::string path = Utils::FileSystem::createRelativePath(it.first, relativeTo, true); 
-
-		f << path;
-		f << "|";
-		f << std::to_string(it.second.size);
-		f << "|";
-		f << std::to_string(it.second.x);
-		f << "|";
-		f << std::to_string(it.second.y);
-		f << "\n";
+		FILE* file = fopen(fname.c_str(), "ab");
+		if (file == nullptr)
+			return;
+
+		for (auto path : sizeCachePending)
+		{
+			auto it = sizeCache.find(path);
+			if (it == sizeCache.cend())
+				writeImageCacheRecord(file, path, CachedFileInfo(-1, -1, -1), relativeTo); // removed
+			else if (it->second.size >= 0)
+				writeImageCacheRecord(file, path, it->second, relativeTo);
+			else
+				continue;
+
+			sizeCacheFileRecords++;
+		}
+
+		fclose(file);
 	}
 
-	f.close();
+	sizeCachePending.clear();
+	sizeCacheRewrite = false;
 }
 
-static std::mutex sizeCacheLock;
-
 void ImageIO::removeImageCache(const std::string fn)
 {
 	std::unique_lock<std::mutex> lock(sizeCacheLock);
 
 	auto it = sizeCache.find(fn);
 	if (it != sizeCache.cend())
-		sizeCache.erase(fn);
+	{
+		if (it->second.size > 0 && _isCachablePath(fn))
+			sizeCachePending.push_back(fn);
+
+		sizeCache.erase(it);
+	}
 }
 
 void ImageIO::updateImageCache(const std::string fn, int sz, int x, int y)
@@ -355,7 +446,7 @@ void ImageIO::updateImageCache(const std::string fn, int sz, int x, int y)
 			item.size = sz;
 
 			if (sz > 0 && x > 0 && _isCachablePath(fn))
-				sizeCacheDirty = true;
+				sizeCachePending.push_back(fn);
 		}
 	}
 	else
@@ -363,10 +454,44 @@ void ImageIO::updateImageCache(const std::string fn, int sz, int x, int y)
 		sizeCache[fn] = CachedFileInfo(sz, x, y);
 
 		if (sz > 0 && x > 0 && _isCachablePath(fn))
-			sizeCacheDirty = true;
+			sizeCachePending.push_back(fn);
 	}
 }
 
+void ImageIO::buildImageCacheAsync(const std::vector<std::string>& paths)
+{
+	stopImageCacheBuild();
+
+	if (paths.size() == 0)
+		return;
+
+	sizeCacheBuilderExit = false;
+	sizeCacheBuilder = new std::thread([paths]
+	{
+		LOG(LogDebug) << "ImageIO::buildImageCacheAsync\tProbing " << paths.size() << " images";
+
+		unsigned int x, y;
+		for (auto path : paths)
+		{
+			if (sizeCacheBuilderExit)
+				break;
+
+			ImageIO::loadImageSize(path.c_str(), &x, &y);
+		}
+	});
+}
+
+void ImageIO::stopImageCacheBuild()
+{
+	if (sizeCacheBuilder == nullptr)
+		return;
+
+	sizeCacheBuilderExit = true;
+	sizeCacheBuilder->join();
+
+	delete sizeCacheBuilder;
+	sizeCacheBuilder = nullptr;
+}
 
 bool ImageIO::loadImageSize(const char *fn, unsigned int *x, unsigned int *y)
 {
@@ -388,7 +513,31 @@ bool ImageIO::loadImageSize(const char *fn, unsigned int *x, unsigned int *y)
 	LOG(LogDebug) << "ImageIO::loadImageSize " << fn;
 
 	auto ext = Utils::String::toLower(Utils::FileSystem::getExtension(fn));
-	if (ext != ".jpg" && ext != ".png" && ext != ".jpeg" && ext != ".gif")
+
+	if (ext == ".svg")
+	{
+		// SVG sizes come from the document attributes, let nanosvg deal with units and viewBox
+		NSVGimage* svgImage = nsvgParseFromFile(fn, "px", 96);
+		if (svgImage == nullptr || svgImage->width <= 0 || svgImage->height <= 0)
+		{
+			if (svgImage != nullptr)
+				nsvgDelete(svgImage);
+
+			updateImageCache(fn, -1, -1, -1);
+			return false;
+		}
+
+		*x = (unsigned int)Math::round(svgImage->width);
+		*y = (unsigned int)Math::round(svgImage->height);
+		nsvgDelete(svgImage);
+
+		LOG(LogDebug) << "ImageIO::loadImageSize\tSVG size " << std::string(std::to_string(*x) + "x" + std::to_string(*y)).c_str();
+
+		updateImageCache(fn, Utils::FileSystem::getFileSize(fn), *x, *y);
+		return true;
+	}
+
+	if (ext != ".jpg" && ext != ".png" && ext != ".jpeg" && ext != ".gif" && ext != ".webp")
 	{
 		LOG(LogWarning) << "ImageIO::loadImageSize\tUnknown file type";
 		return false;
@@ -412,11 +561,14 @@ bool ImageIO::loadImageSize(const char *fn, unsigned int *x, unsigned int *y)
 	// Strategy:
 	// reading GIF dimensions requires the first 10 bytes of the file
 	// reading PNG dimensions requires the first 24 bytes of the file
+	// reading WEBP dimensions requires the first 30 bytes of the file
 	// reading JPEG dimensions requires scanning through jpeg chunks
 	// In all formats, the file is at least 24 bytes big, so we'll read that always
-	unsigned char buf[24]; 
-	if (fread(buf, 1, 24, f) != 24)
+	unsigned char buf[30]; 
+	size_t headerSize = fread(buf, 1, 30, f);
+	if (headerSize < 24)
 	{
+		fclose(f);
 		updateImageCache(fn, -1, -1, -1);
 		return false;
 	}
@@ -490,7 +642,136 @@ bool ImageIO::loadImageSize(const char *fn, unsigned int *x, unsigned int *y)
 		return true;
 	}
 
+	// WEBP: RIFF container, the first chunk gives the dimensions. Format depends on the encoding
+	if (headerSize == 30 && buf[0] == 'R' && buf[1] == 'I' && buf[2] == 'F' && buf[3] == 'F' && buf[8] == 'W' && buf[9] == 'E' && buf[10] == 'B' && buf[11] == 'P' && buf[12] == 'V' && buf[13] == 'P' && buf[14] == '8')
+	{
+		bool found = true;
+
+		if (buf[15] == ' ') // Lossy
+		{
+			*x = (buf[26] | (buf[27] << 8)) & 0x3FFF;
+			*y = (buf[28] | (buf[29] << 8)) & 0x3FFF;
+		}
+		else if (buf[15] == 'L' && buf[20] == 0x2F) // Lossless
+		{
+			*x = 1 + (((buf[22] & 0x3F) << 8) | buf[21]);
+			*y = 1 + (((buf[24] & 0x0F) << 10) | (buf[23] << 2) | ((buf[22] & 0xC0) >> 6));
+		}
+		else if (buf[15] == 'X') // Extended
+		{
+			*x = 1 + (buf[24] | (buf[25] << 8) | (buf[26] << 16));
+			*y = 1 + (buf[27] | (buf[28] << 8) | (buf[29] << 16));
+		}
+		else
+			found = false;
+
+		if (found)
+		{
+			LOG(LogDebug) << "ImageIO::loadImageSize\tWEBP size " << std::string(std::to_string(*x) + "x" + std::to_string(*y)).c_str();
+
+			updateImageCache(fn, size, *x, *y);
+			return true;
+		}
+	}
+
 	updateImageCache(fn, -1, -1, -1);
 	LOG(LogWarning) << "ImageIO::loadImageSize\tUnable to extract size";
 	return false;
 }
+
+bool ImageIO::createMosaic(const std::vector<std::string>& images, int columns, int rows, int width, int height, int padding, const std::string& destination)
+{
+	if (images.size() == 0 || columns <= 0 || rows <= 0 || width <= 0 || height <= 0)
+		return false;
+
+	FIBITMAP* mosaic = FreeImage_Allocate(width, height, 32);
+	if (mosaic == nullptr)
+		return false;
+
+	int cellWidth = width / columns;
+	int cellHeight = height / rows;
+
+	// A thumbnail FreeImage can't read (svg...) would leave a hole : the caller keeps its grid of images instead
+	bool failed = false;
+
+	int idx = 0;
+	for (int x = 0; x < columns && idx < images.size() && !failed; x++)
+	{
+		for (int y = 0; y < rows && idx < images.size() && !failed; y++)
+		{
+			const std::string& path = images[idx++];
+			failed = true; // until the thumbnail is pasted
+
+			FREE_IMAGE_FORMAT format = FreeImage_GetFileType(path.c_str(), 0);
+			if (format == FIF_UNKNOWN)
+				format = FreeImage_GetFIFFromFilename(path.c_str());
+
+			if (format == FIF_UNKNOWN || !FreeImage_FIFSupportsReading(format))
+				continue;
+
+			FIBITMAP* image = FreeImage_Load(format, path.c_str());
+			if (image == nullptr)
+				continue;
+
+			if (FreeImage_GetBPP(image) != 32)
+			{
+				FIBITMAP* converted = FreeImage_ConvertTo32Bits(image);
+				FreeImage_Unload(image);
+				image = converted;
+
+				if (image == nullptr)
+					continue;
+			}
+
+			// Fit in the cell, keeping the aspect ratio
+			int imageWidth = FreeImage_GetWidth(image);
+			int imageHeight = FreeImage_GetHeight(image);
+
+			float scale = Math::min((float)Math::max(1, cellWidth - 2 * padding) / imageWidth, (float)Math::max(1, cellHeight - 2 * padding) / imageHeight);
+
+			int sx = Math::max(1, (int)(imageWidth * scale));
+			int sy = Math::max(1, (int)(imageHeight * scale));
+
+			if (sx != imageWidth || sy != imageHeight)
+			{
+				FIBITMAP* rescaled = FreeImage_Rescale(image, sx, sy, FILTER_BILINEAR);
+				FreeImage_Unload(image);
+				image = rescaled;
+
+				if (image == nullptr)
+					continue;
+			}
+
+			// Centered in its cell, like ImageComponent does with a max size
+			int left = x * cellWidth + (cellWidth - (int)FreeImage_GetWidth(image)) / 2;
+			int top = y * cellHeight + (cellHeight - (int)FreeImage_GetHeight(image)) / 2;
+
+			FreeImage_Paste(mosaic, image, left, top, 256);
+			FreeImage_Unload(image);
+
+			failed = false;
+		}
+	}
+
+	if (failed)
+	{
+		LOG(LogWarning) << "ImageIO::createMosaic\tFailed to load " << images[idx - 1];
+		FreeImage_Unload(mosaic);
+		return false;
+	}
+
+	bool saved = false;
+
+	try
+	{
+		saved = (FreeImage_Save(FIF_PNG, mosaic, destination.c_str()) != 0);
+	}
+	catch (...) {}
+
+	FreeImage_Unload(mosaic);
+
+	if (!saved)
+		LOG(LogError) << "ImageIO::createMosaic\tFailed to save " << destination;
+
+	return saved;
+}
@@ -3,6 +3,7 @@
 #define ES_CORE_IMAGE_IO
 
 #include <stdlib.h>
+#include <string>
 #include <vector>
 #include "math/Vector2f.h"
 #include "math/Vector2i.h"
@@ -51,11 +52,19 @@ public:
 	static Vector2i adjustPictureSize(Vector2i imageSize, Vector2i maxSize, bool externSize = false);
 	static bool		loadImageSize(const char *fn, unsigned int *x, unsigned int *y);
 
+	// Composes the images in a columns x rows grid (filled column by column), each one fitted in its cell, and saves it as png.
+	// Returns false without saving if any image can't be loaded
+	static bool		createMosaic(const std::vector<std::string>& images, int columns, int rows, int width, int height, int padding, const std::string& destination);
+
 	static void		removeImageCache(const std::string fn);
 	static void		updateImageCache(const std::string fn, int sz, int x, int y);
 	static void		loadImageCache();
 	static void		saveImageCache();
 	static void		clearImageCache();
+
+	// Probes the sizes of the given images in a background thread, so they are known before the images are displayed
+	static void		buildImageCacheAsync(const std::vector<std::string>& paths);
+	static void		stopImageCacheBuild();
 };
 
 #endif // ES_CORE_IMAGE_IO
@@ -42,6 +42,7 @@ public:
 	int getNumConfiguredDevices();
 
 	std::vector<InputConfig*> getInputConfigs();
+	InputConfig* getInputConfigByDevice(int deviceId);
 
 	bool parseEvent(const SDL_Event& ev, Window* window);
 
@@ -79,8 +80,6 @@ private:
 
 	bool tryLoadInputConfig(std::string path, InputConfig* config, bool allowApproximate = true);
 
-	InputConfig* getInputConfigByDevice(int deviceId);
-
 	void clearJoysticks();
 	void rebuildAllJoysticks(bool deinit = true);
 };
@@ -66,6 +66,7 @@ void Settings::setDefaults()
 	mBoolMap["ShowHiddenFiles"] = false;
 	mBoolMap["ShowParentFolder"] = true;
 	mBoolMap["DrawFramerate"] = false;
+	mBoolMap["IdleFrameSkipping"] = true;
 	mBoolMap["ShowExit"] = true;
 	mBoolMap["Windowed"] = false;
 	mBoolMap["SplashScreen"] = true;
@@ -261,6 +262,14 @@ void Settings::setDefaults()
 	mBoolMap["AsyncImages"] = true;
 	mBoolMap["PreloadUI"] = false;
 	mBoolMap["OptimizeVRAM"] = true;
+	mBoolMap["TextureAtlas"] = true;
+	mBoolMap["TextureMipmaps"] = true;
+	mBoolMap["FontDistanceField"] = false;
+	mBoolMap["BatchRendering"] = true;
+	mBoolMap["BitmapCaching"] = true; // components flagged cacheAsBitmap are drawn once to a texture
+	mIntMap["TextureUploadBudget"] = 4;
+	mIntMap["GamelistPrefetch"] = 6; // games loaded ahead of the cursor, 0 disables
+	mIntMap["SystemExtrasRadius"] = 2; // systems around the cursor keeping their theme extras, 0 keeps them all
 	mBoolMap["OptimizeVideo"] = true;
 
 	mBoolMap["ShowFilenames"] = false;
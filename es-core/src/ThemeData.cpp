@@ -42,7 +42,8 @@ std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>> The
 		{ "offset", NORMALIZED_PAIR },
 		{ "offsetX", FLOAT },
 		{ "offsetY", FLOAT },
-		{ "clipRect", NORMALIZED_RECT } } },
+		{ "clipRect", NORMALIZED_RECT },
+		{ "cacheAsBitmap", BOOLEAN } } },
 
 	{ "image", {
 		{ "pos", NORMALIZED_PAIR },
@@ -79,6 +80,7 @@ std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>> The
 		{ "horizontalAlignment", STRING },		
 		{ "verticalAlignment", STRING },
 		{ "roundCorners", FLOAT },
+		{ "saturation", FLOAT },
 		{ "opacity", FLOAT },
 		{ "flipX", BOOLEAN },
 		{ "flipY", BOOLEAN },
@@ -171,6 +173,7 @@ std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>> The
 		{ "autoScroll", STRING },
 		{ "padding", NORMALIZED_RECT },
 		{ "visible", BOOLEAN },
+		{ "cacheAsBitmap", BOOLEAN },
 		{ "zIndex", FLOAT } } },
 	{ "textlist", {
 		{ "pos", NORMALIZED_PAIR },
@@ -236,6 +239,7 @@ std::map<std::string, std::map<std::string, ThemeData::ElementPropertyType>> The
 
 		{ "path", PATH },
 	 	{ "visible", BOOLEAN },
+		{ "cacheAsBitmap", BOOLEAN },
 		{ "color", COLOR },
 		{ "cornerSize", NORMALIZED_PAIR },
 		{ "centerColor", COLOR },
@@ -566,7 +570,7 @@ ThemeData::ThemeData()
 	mVersion = 0;
 }
 
-void ThemeData::loadFile(const std::string system, std::map<std::string, std::string> sysDataMap, const std::string& path, bool fromFile)
+void ThemeData::loadFile(const std::string system, std::map<std::string, std::string> sysDataMap, const std::string& path, bool fromFile, bool setDefault)
 {
 	mPaths.push_back(path);
 
@@ -621,7 +625,7 @@ void ThemeData::loadFile(const std::string system, std::map<std::string, std::st
 		}
 	}
 
-	if (system != "splash" && system != "imageviewer")
+	if (setDefault && system != "splash" && system != "imageviewer")
 	{
 		mMenuTheme = nullptr;
 		mDefaultTheme = this;
@@ -290,7 +290,8 @@ public:
 	ThemeData();
 
 	// throws ThemeException
-	void loadFile(const std::string system, std::map<std::string, std::string> sysDataMap, const std::string& path, bool fromFile = true);
+	// setDefault : makes it the default theme, used by menus. Must be false when not loading on the UI thread
+	void loadFile(const std::string system, std::map<std::string, std::string> sysDataMap, const std::string& path, bool fromFile = true, bool setDefault = true);
 
 	enum ElementPropertyType
 	{
@@ -28,8 +28,8 @@
 #include "utils/FileSystemUtil.h"
 #endif
 
-Window::Window() : mNormalizeNextUpdate(false), mFrameTimeElapsed(0), mFrameCountElapsed(0), mAverageDeltaTime(10),
-  mAllowSleep(true), mSleeping(false), mTimeSinceLastInput(0), mScreenSaver(NULL), mRenderScreenSaver(false), mClockElapsed(0) // batocera
+Window::Window() : mNormalizeNextUpdate(false), mFrameTimeElapsed(0), mFrameCountElapsed(0), mFrameSkippedElapsed(0), mAverageDeltaTime(10),
+  mAllowSleep(true), mSleeping(false), mTimeSinceLastInput(0), mTimeSinceLastRender(0), mScreenSaver(NULL), mRenderScreenSaver(false), mClockElapsed(0) // batocera
 {		
 	mTransitionOffset = 0;
 
@@ -65,6 +65,8 @@ void Window::pushGui(GuiComponent* gui)
 	gui->onShow();
 	mGuiStack.push_back(gui);
 	gui->updateHelpPrompts();
+
+	GuiComponent::invalidate();
 }
 
 void Window::removeGui(GuiComponent* gui)
@@ -76,6 +78,8 @@ void Window::removeGui(GuiComponent* gui)
 			gui->onHide();
 			i = mGuiStack.erase(i);
 
+			GuiComponent::invalidate();
+
 			if(i == mGuiStack.cend() && mGuiStack.size()) // we just popped the stack and the stack is not empty
 			{
 				mGuiStack.back()->updateHelpPrompts();
@@ -115,6 +119,9 @@ bool Window::init(bool initRenderer, bool initInputManager)
 
 	ResourceManager::getInstance()->reloadAll();
 
+	// Help prompts only change with the prompts and the style
+	mHelp->setCacheAsBitmap(true);
+
 	//keep a reference to the default fonts, so they don't keep getting destroyed/recreated
 	if(mDefaultFonts.empty())
 	{
@@ -197,6 +204,8 @@ void Window::deinit(bool deinitRenderer)
 
 void Window::textInput(const char* text)
 {
+	GuiComponent::invalidate();
+
 	if(peekGui())
 		peekGui()->textInput(text);
 }
@@ -209,6 +218,8 @@ void Window::input(InputConfig* config, Input input)
 	if (config->getDeviceIndex() > 0 && Settings::getInstance()->getBool("FirstJoystickOnly"))
 		return;
 
+	GuiComponent::invalidate();
+
 	if (mScreenSaver) 
 	{
 		if (mScreenSaver->isScreenSaverActive() && Settings::getInstance()->getBool("ScreenSaverControls") &&
@@ -451,11 +462,22 @@ void Window::update(int deltaTime)
 
 			ss << "\nFont VRAM: " << fontVramUsageMb << " Tex VRAM: " << textureVramUsageMb <<
 				" Tex Max: " << textureTotalUsageMb;
+
+			// draw calls of the last frame
+			const Renderer::FrameStats& stats = Renderer::getFrameStats();
+			ss << "\nDraws: " << stats.draws << " Draw calls: " << stats.drawCalls <<
+				" Binds: " << stats.textureBinds << " Blend: " << stats.blendChanges << " Programs: " << stats.programSwitches << " Caches: " << stats.renderTargetUpdates;
+			// frames which have not been redrawn because nothing changed
+			if (Settings::getInstance()->getBool("IdleFrameSkipping"))
+				ss << "\nIdle frames: " << (100 * mFrameSkippedElapsed / mFrameCountElapsed) << "%";
+
 			mFrameDataText = std::unique_ptr<TextCache>(mDefaultFonts.at(1)->buildTextCache(ss.str(), 50.f, 50.f, 0xFF00FFFF));
+			GuiComponent::invalidate();
 		}
 
 		mFrameTimeElapsed = 0;
 		mFrameCountElapsed = 0;
+		mFrameSkippedElapsed = 0;
 	}
 
 	/* draw the clock */ // batocera
@@ -486,6 +508,7 @@ void Window::update(int deltaTime)
 	}
 
 	mTimeSinceLastInput += deltaTime;
+	mTimeSinceLastRender += deltaTime;
 
 	if (peekGui())
 		peekGui()->update(deltaTime);
@@ -507,11 +530,37 @@ void Window::update(int deltaTime)
 	AudioManager::update(deltaTime);
 }
 
+bool Window::isRenderNeeded()
+{
+	// Always consume the invalidation, it must not leak to the next frame when skipping is disabled
+	bool invalidated = GuiComponent::validate();
+
+	if (invalidated || !Settings::getInstance()->getBool("IdleFrameSkipping"))
+		return true;
+
+	// Still redraw from time to time, for anything changing without invalidating
+	if (mTimeSinceLastRender >= IDLE_REDRAW_DELAY)
+		return true;
+
+	// The screensaver and notifications animate by themselves
+	if (mRenderScreenSaver || mNotificationPopups.size() || mAsyncNotificationComponent.size())
+		return true;
+
+	// Give the screensaver a chance to start
+	unsigned int screensaverTime = (unsigned int)Settings::getInstance()->getInt("ScreenSaverTime");
+	if (mTimeSinceLastInput >= screensaverTime && screensaverTime != 0)
+		return true;
+
+	mFrameSkippedElapsed++;
+	return false;
+}
+
 void Window::render()
 {
 	Transform4x4f transform = Transform4x4f::Identity();
 
 	mRenderedHelpPrompts = false;
+	mTimeSinceLastRender = 0;
 
 	// draw only bottom and top of GuiStack (if they are different)
 	if(mGuiStack.size())
@@ -549,7 +598,7 @@ void Window::render()
 	
 	if (mGuiStack.size() < 2 || !Renderer::isSmallScreen())
 		if(!mRenderedHelpPrompts)
-			mHelp->render(transform);
+			mHelp->renderCached(transform);
 
 	if(Settings::getInstance()->getBool("DrawFramerate") && mFrameDataText)
 	{
@@ -587,7 +636,7 @@ void Window::render()
 	renderScreenSaver();
 
 	for (auto extra : mScreenExtras)
-		extra->render(transform);
+		extra->renderCached(transform);
 
 	if (mVolumeInfo && Settings::getInstance()->getBool("VolumePopup"))
 		mVolumeInfo->render(transform);
@@ -655,7 +704,7 @@ void Window::closeSplashScreen()
 
 void Window::renderHelpPromptsEarly()
 {
-	mHelp->render(Transform4x4f::Identity());
+	mHelp->renderCached(Transform4x4f::Identity());
 	mRenderedHelpPrompts = true;
 }
 
@@ -668,6 +717,8 @@ void Window::setHelpPrompts(const std::vector<HelpPrompt>& prompts, const HelpSt
 	mHelp->clearPrompts();
 	mHelp->setStyle(style);
 
+	GuiComponent::invalidate();
+
 	mClockElapsed = -1;
 
 	std::vector<HelpPrompt> addPrompts;
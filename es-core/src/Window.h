@@ -59,6 +59,9 @@ public:
 	void update(int deltaTime);
 	void render();
 
+	// Returns false if nothing changed since the last rendered frame, which can stay on screen
+	bool isRenderNeeded();
+
 	bool init(bool initRenderer = true, bool initInputManager = true);
 	void deinit(bool deinitRenderer = true);
 
@@ -96,6 +99,8 @@ public:
 	AsyncNotificationComponent* createAsyncNotificationComponent(bool actionLine = false);
 
 private:
+	static const unsigned int IDLE_REDRAW_DELAY = 1000;
+
 	void processPostedFunctions();
 
 	std::vector<AsyncNotificationComponent*> mAsyncNotificationComponent;
@@ -139,6 +144,7 @@ private:
 
 	int mFrameTimeElapsed;
 	int mFrameCountElapsed;
+	int mFrameSkippedElapsed;
 	int mAverageDeltaTime;
 
 	std::unique_ptr<TextCache> mFrameDataText;
@@ -154,6 +160,7 @@ private:
 	bool mAllowSleep;
 	bool mSleeping;
 	unsigned int mTimeSinceLastInput;
+	unsigned int mTimeSinceLastRender;
 
 	bool mRenderedHelpPrompts;
 
@@ -59,6 +59,7 @@ void AnimatedImageComponent::update(int deltaTime)
 
 	while(mFrames.at(mCurrentFrame).second <= mFrameAccumulator)
 	{
+		invalidateContent();
 		mCurrentFrame++;
 
 		if(mCurrentFrame == (int)mFrames.size())
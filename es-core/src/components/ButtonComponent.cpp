@@ -60,6 +60,7 @@ void ButtonComponent::setText(const std::string& text, const std::string& helpTe
 	mHelpText = helpText;
 	
 	mTextCache = std::unique_ptr<TextCache>(mFont->buildTextCache(mText, 0, 0, getCurTextColor()));
+	invalidateContent();
 
 	float padding = TEXT_PADDING;
 	float minWidth = mFont->sizeText("DELETE").x() + padding;
@@ -94,6 +95,9 @@ void ButtonComponent::setEnabled(bool enabled)
 
 void ButtonComponent::updateImage()
 {
+	// The box is not a child
+	invalidateContent();
+
 	if (!mEnabled || !mPressedFunc)
 	{
 		mBox.setImagePath(":/button_filled.png");
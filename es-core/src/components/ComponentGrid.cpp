@@ -377,6 +377,8 @@ void ComponentGrid::textInput(const char* text)
 
 void ComponentGrid::onCursorMoved(Vector2i from, Vector2i to)
 {
+	invalidateContent();
+
 	const GridEntry* cell = getCellAt(from);
 	if(cell)
 		cell->component->onFocusLost();
@@ -150,8 +150,13 @@ bool ComponentList::input(InputConfig* config, Input input)
 
 void ComponentList::update(int deltaTime)
 {
+	const bool scrollbarVisible = mScrollbar.isVisible();
 	mScrollbar.update(deltaTime);
 
+	// The scrollbar is not a child
+	if (mScrollbar.isFading() || mScrollbar.isVisible() != scrollbarVisible)
+		invalidateContent();
+
 	listUpdate(deltaTime);
 
 	if(size())
@@ -173,6 +178,9 @@ void ComponentList::update(int deltaTime)
 
 void ComponentList::onCursorChanged(const CursorState& state)
 {
+	// Selector bar and camera
+	invalidateContent();
+
 	mScrollbar.onCursorChanged();
 
 	// update the selector bar position
@@ -95,6 +95,8 @@ void ComponentTab::update(int deltaTime)
 
 void ComponentTab::onCursorChanged(const CursorState& state)
 {
+	invalidateContent();
+
 	// update the selector bar position
 	// in the future this might be animated
 	mSelectorBarOffset = 0;
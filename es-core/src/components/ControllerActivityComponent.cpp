@@ -495,6 +495,8 @@ int ControllerActivityComponent::renderTexture(float x, float w, std::shared_ptr
 	vertices[2] = { { left + sz.x(), top },{ 1.0f, 1.0f }, clr };
 	vertices[3] = { { left + sz.x(), sz.y() },{ 1.0f, 0.0f }, clr };
 
+	texture->mapTextureCoords(vertices, 4);
+
 	Renderer::drawTriangleStrips(&vertices[0], 4);
 	Renderer::bindTexture(0);
 
@@ -32,6 +32,8 @@ bool DateTimeEditComponent::input(InputConfig* config, Input input)
 		if(mDisplayMode != DISP_RELATIVE_TO_NOW) //don't allow editing for relative times
 			mEditing = !mEditing;
 
+		invalidateContent();
+
 		if(mEditing)
 		{
 			//started editing
@@ -121,6 +123,8 @@ bool DateTimeEditComponent::input(InputConfig* config, Input input)
 			mEditIndex++;
 			if(mEditIndex >= (int)mCursorBoxes.size())
 				mEditIndex--;
+
+			invalidateContent();
 			return true;
 		}
 		
@@ -129,6 +133,8 @@ bool DateTimeEditComponent::input(InputConfig* config, Input input)
 			mEditIndex--;
 			if(mEditIndex < 0)
 				mEditIndex++;
+
+			invalidateContent();
 			return true;
 		}
 	}
@@ -259,6 +265,8 @@ std::shared_ptr<Font> DateTimeEditComponent::getFont() const
 
 void DateTimeEditComponent::updateTextCache()
 {
+	invalidateContent();
+
 	DisplayMode mode = getCurrentDisplayMode();
 	const std::string dispString = mUppercase ? Utils::String::toUpper(getDisplayString(mode)) : getDisplayString(mode);
 	std::shared_ptr<Font> font = getFont();
@@ -37,6 +37,7 @@ GridTileComponent::GridTileComponent(Window* window) : GuiComponent(window), mBa
 
 	mImage = new ImageComponent(mWindow);
 	mImage->setOrigin(0.5f, 0.5f);
+	mImage->setMipmapped(true);
 
 	mLabel.setFont(Font::get(FONT_SIZE_SMALL));
 	mLabel.setDefaultZIndex(10);
@@ -73,6 +74,7 @@ void GridTileComponent::resetProperties()
 void GridTileComponent::forceSize(Vector2f size, float selectedZoom)
 {
 	mSize = size;
+	mTransformDirty = true;
 	mDefaultProperties.Size = size;
 	mSelectedProperties.Size = size * selectedZoom;
 	mVideoPlayingProperties.Size = mSelectedProperties.Size;
@@ -304,7 +306,10 @@ void GridTileComponent::update(int deltaTime)
 	GuiComponent::update(deltaTime);
 
 	if (mVideo != nullptr && mVideo->isPlaying() && mVideo->isFading())
+	{
 		resize();
+		invalidateContent();
+	}
 }
 
 void GridTileComponent::renderBackground(const Transform4x4f& parentTrans)
@@ -1110,6 +1115,9 @@ void GridTileComponent::setSelectedZoom(float percent)
 
 	mSelectedZoomPercent = percent;
 	resize();
+
+	// Selection animations interpolate the tile properties : they are drawn without going through the setters
+	invalidateContent();
 }
 
 Vector3f GridTileComponent::getBackgroundPosition()
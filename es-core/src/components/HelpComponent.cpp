@@ -55,6 +55,8 @@ void HelpComponent::setStyle(const HelpStyle& style)
 
 void HelpComponent::updateGrid()
 {
+	invalidateContent();
+
 	if (!Settings::getInstance()->getBool("ShowHelpPrompts") || mPrompts.empty())
 	{
 		mGrid.reset();
@@ -159,10 +161,27 @@ void HelpComponent::setOpacity(unsigned char opacity)
 {
 	GuiComponent::setOpacity(opacity);
 
+	// Cached : the opacity is applied to the picture of the grid
+	if (isCacheAsBitmap() || mGrid == nullptr)
+		return;
+
 	for (unsigned int i = 0; i < mGrid->getChildCount(); i++)
 		mGrid->getChild(i)->setOpacity(opacity);
 }
 
+Vector4f HelpComponent::getBitmapCacheBounds()
+{
+	// The grid is not a child
+	if (mGrid == nullptr)
+		return Vector4f(0, 0, 0, 0);
+
+	const Vector2f size = mGrid->getSize();
+	const float x = std::floor(mGrid->getPosition().x() - mGrid->getOrigin().x() * size.x());
+	const float y = std::floor(mGrid->getPosition().y() - mGrid->getOrigin().y() * size.y());
+
+	return Vector4f(x, y, std::ceil(size.x()) + 1, std::ceil(size.y()) + 1);
+}
+
 void HelpComponent::render(const Transform4x4f& parentTrans)
 {
 	Transform4x4f trans = parentTrans * getTransform();
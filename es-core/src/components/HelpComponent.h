@@ -25,6 +25,9 @@ public:
 
 	std::shared_ptr<ComponentGrid> getGrid() { return mGrid; };
 
+protected:
+	Vector4f getBitmapCacheBounds() override;
+
 private:
 	std::shared_ptr<TextureResource> getIconTexture(const char* name);
 	std::map< std::string, std::shared_ptr<TextureResource> > mIconCache;
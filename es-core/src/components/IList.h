@@ -7,6 +7,7 @@
 #include "resources/Font.h"
 #include "PowerSaver.h"
 #include "ThemeData.h"
+#include <functional>
 #include <vector>
 
 enum CursorState
@@ -55,9 +56,12 @@ class IList : public GuiComponent
 public:
 	struct Entry
 	{
+		Entry() : loaded(true) { }
+
 		std::string name;
 		UserData object;
 		EntryData data;
+		bool loaded; // false until the entry loader has filled name and data
 	};
 
 protected:
@@ -78,6 +82,8 @@ protected:
 	const ListLoopType mLoopType;
 
 	std::vector<Entry> mEntries;
+
+	std::function<void(Entry& entry)> mEntryLoader;
 	
 public:
 	IList(Window* window, const ScrollTierList& tierList = LIST_SCROLL_STYLE_QUICK, const ListLoopType& loopType = LIST_PAUSE_AT_END) : GuiComponent(window), 
@@ -154,7 +160,7 @@ public:
 	inline const std::string& getSelectedName()
 	{
 		assert(size() > 0);
-		return mEntries.at(mCursor).name;
+		return loadEntry(mCursor).name;
 	}
 
 	inline const UserData& getSelected() const
@@ -206,6 +212,18 @@ public:
 		mEntries.push_back(e);
 	}
 
+	// Huge lists are virtualized : entries added unloaded only hold their object until they get near the visible part of the list,
+	// then the loader fills their name and data
+	void addUnloaded(const Entry& e)
+	{
+		mEntries.push_back(e);
+		mEntries.back().loaded = false;
+	}
+
+	void setEntryLoader(const std::function<void(Entry& entry)>& loader) { mEntryLoader = loader; }
+
+	void reserve(int count) { mEntries.reserve(count); }
+
 	bool remove(const UserData& obj)
 	{
 		for(auto it = mEntries.cbegin(); it != mEntries.cend(); it++)
@@ -222,6 +240,8 @@ public:
 
 	inline int size() const { return (int)mEntries.size(); }
 
+	inline const UserData& getObjectAt(int index) const { return mEntries.at(index).object; }
+
 	inline std::vector<UserData> getObjects()
 	{
 		std::vector<UserData> objects;
@@ -232,6 +252,20 @@ public:
 	}
 
 protected:
+	Entry& loadEntry(int index)
+	{
+		Entry& entry = mEntries.at(index);
+		if (!entry.loaded)
+		{
+			entry.loaded = true;
+
+			if (mEntryLoader)
+				mEntryLoader(entry);
+		}
+
+		return entry;
+	}
+
 	void remove(typename std::vector<Entry>::const_iterator& it)
 	{
 		if(mCursor > 0 && it - mEntries.cbegin() <= mCursor)
@@ -274,6 +308,7 @@ protected:
 		// update the title overlay opacity
 		const int dir = (mScrollTier >= mTierList.count - 1) ? 1 : -1; // fade in if scroll tier is >= 1, otherwise fade out
 		int op = mTitleOverlayOpacity + deltaTime*dir; // we just do a 1-to-1 time -> opacity, no scaling
+		const unsigned char titleOverlayOpacity = mTitleOverlayOpacity;
 		if(op >= 255)
 			mTitleOverlayOpacity = 255;
 		else if(op <= 0)
@@ -281,9 +316,14 @@ protected:
 		else
 			mTitleOverlayOpacity = (unsigned char)op;
 
+		if (mTitleOverlayOpacity != titleOverlayOpacity)
+			invalidateContent();
+
 		if(mScrollVelocity == 0 || size() < 2)
 			return;
 
+		invalidateContent();
+
 		mScrollCursorAccumulator += deltaTime;
 		mScrollTierAccumulator += deltaTime;
 
@@ -30,11 +30,13 @@ ImageComponent::ImageComponent(Window* window, bool forceLoad, bool dynamic) : G
 	mCheckClipping = true;
 
 	mLinear = false;
+	mMipmapped = false;
 	mHorizontalAlignment = ALIGN_CENTER;
 	mVerticalAlignment = ALIGN_CENTER;
 	mReflectOnBorders = false;
 	mAllowFading = true;
 	mRoundCorners = 0.0f;
+	mSaturation = 1.0f;
 	
 	mPlaylistTimer = 0;
 	updateColors();
@@ -48,6 +50,9 @@ ImageComponent::~ImageComponent()
 
 void ImageComponent::resize()
 {
+	// mSize is written directly, by the callers too
+	mTransformDirty = true;
+
 	if(!mTexture)
 		return;
 
@@ -191,10 +196,42 @@ void ImageComponent::setImage(std::string path, bool tile, MaxSizeInfo maxSize,
 	if (isShowing() && mTexture != nullptr)
 		mTexture->setRequired(true);
 
+	if (mMipmapped)
+	{
+		if (mTexture != nullptr)
+			mTexture->setMipmapped(true);
+
+		if (mLoadingTexture != nullptr)
+			mLoadingTexture->setMipmapped(true);
+	}
+
 	if (mLoadingTexture == nullptr)
 		resize();
 }
 
+std::shared_ptr<TextureResource> ImageComponent::prefetchImage(const std::string& path)
+{
+	// Force loaded images are read synchronously by setImage anyway
+	if (path.empty() || path[0] == '{' || mForceLoad || !mDynamic)
+		return nullptr;
+
+	MaxSizeInfo maxSize = getMaxSizeInfo();
+
+	std::shared_ptr<TextureResource> texture = TextureResource::get(path, false, mLinear, false, mDynamic, true, maxSize.empty() ? nullptr : &maxSize);
+	if (texture != nullptr)
+		texture->prefetch();
+
+	return texture;
+}
+
+void ImageComponent::setMipmapped(bool value)
+{
+	mMipmapped = value;
+
+	if (mMipmapped && mTexture != nullptr)
+		mTexture->setMipmapped(true);
+}
+
 void ImageComponent::setImage(const char* path, size_t length, bool tile)
 {
 	mPath = "";
@@ -269,6 +306,7 @@ Vector2f ImageComponent::getRotationSize() const
 void ImageComponent::setRotateByTargetSize(bool rotate)
 {
 	mRotateByTargetSize = rotate;
+	mTransformDirty = true;
 }
 
 void ImageComponent::cropLeft(float percent)
@@ -359,6 +397,8 @@ void ImageComponent::updateVertices()
 	if(!mTexture)
 		return;
 
+	invalidateContent();
+
 	// we go through this mess to make sure everything is properly rounded
 	// if we just round vertices at the end, edge cases occur near sizes of 0.5
 	const Vector2f     topLeft     = { mSize * mTopLeftCrop };
@@ -402,6 +442,8 @@ void ImageComponent::updateVertices()
 
 void ImageComponent::updateColors()
 {
+	invalidateContent();
+
 	float opacity = (mOpacity * (mFading ? mFadeOpacity / 255.0 : 1.0)) / 255.0;
 
 	const unsigned int color = Renderer::convertColor(mColorShift & 0xFFFFFF00 | (unsigned char)((mColorShift & 0xFF) * opacity));
@@ -415,11 +457,11 @@ void ImageComponent::updateColors()
 
 void ImageComponent::updateRoundCorners()
 {
+	// Stencil geometry is only built at render, if the renderer can't mask the corners itself
+	mRoundCornerStencil.clear();
+
 	if (mRoundCorners <= 0)
-	{
-		mRoundCornerStencil.clear();
 		return;
-	}
 	
 	float x = 0;
 	float y = 0;
@@ -436,8 +478,7 @@ void ImageComponent::updateRoundCorners()
 		size_y = mTargetSize.y();
 	}
 
-	float radius = Math::max(size_x, size_y) * mRoundCorners;
-	mRoundCornerStencil = Renderer::createRoundRect(x, y, size_x, size_y, radius);
+	mRoundCornerRect = Vector4f(x, y, size_x, size_y);
 }
 
 void ImageComponent::render(const Transform4x4f& parentTrans)
@@ -482,7 +523,21 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 		// The bind() function returns false if the texture is not currently loaded. A blank
 		// texture is bound in this case but we want to handle a fade so it doesn't just 'jump' in
 		// when it finally loads
-		if (!mTexture->bind())
+		bool bound;
+
+		if (mMipmapped)
+		{
+			// On-screen size, scale animations included
+			Vector2f displaySize(
+				mSize.x() * sqrtf(trans.r0().x() * trans.r0().x() + trans.r0().y() * trans.r0().y()),
+				mSize.y() * sqrtf(trans.r1().x() * trans.r1().x() + trans.r1().y() * trans.r1().y()));
+
+			bound = mTexture->bind(displaySize);
+		}
+		else
+			bound = mTexture->bind();
+
+		if (!bound)
 		{
 			fadeIn(false);
 			return;
@@ -507,12 +562,31 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 
 		fadeIn(true);
 
-		if (mRoundCorners > 0 && mRoundCornerStencil.size() > 0)
+		// Atlased textures only use a sub-rectangle of the bound texture
+		Renderer::Vertex vertices[4];
+		for (int i = 0; i < 4; i++)
+			vertices[i] = mVertices[i];
+
+		mTexture->mapTextureCoords(vertices, 4);
+
+		const float radius = mRoundCorners > 0 ? Math::max(mRoundCornerRect.z(), mRoundCornerRect.w()) * mRoundCorners : 0.0f;
+		const bool imageEffect = (radius > 0 || mSaturation != 1.0f) && Renderer::isImageEffectSupported();
+
+		if (imageEffect)
+			Renderer::setImageEffect(mRoundCornerRect.x(), mRoundCornerRect.y(), mRoundCornerRect.z(), mRoundCornerRect.w(), radius, mSaturation);
+		else if (radius > 0)
+		{
+			if (mRoundCornerStencil.size() == 0)
+				mRoundCornerStencil = Renderer::createRoundRect(mRoundCornerRect.x(), mRoundCornerRect.y(), mRoundCornerRect.z(), mRoundCornerRect.w(), radius);
+
 			Renderer::setStencil(mRoundCornerStencil.data(), mRoundCornerStencil.size());
+		}
 
-		Renderer::drawTriangleStrips(&mVertices[0], 4);
+		Renderer::drawTriangleStrips(&vertices[0], 4);
 
-		if (mRoundCorners > 0 && mRoundCornerStencil.size() > 0)
+		if (imageEffect)
+			Renderer::resetImageEffect();
+		else if (radius > 0)
 			Renderer::disableStencil();
 
 		if (mReflection.x() != 0 || mReflection.y() != 0)
@@ -535,26 +609,33 @@ void ImageComponent::render(const Transform4x4f& parentTrans)
 			Renderer::Vertex mirrorVertices[4];
 
 			mirrorVertices[0] = {
-				{ mVertices[0].pos.x(), mVertices[0].pos.y() + h },
-				{ mVertices[0].tex.x(), mVertices[1].tex.y() },
+				{ vertices[0].pos.x(), vertices[0].pos.y() + h },
+				{ vertices[0].tex.x(), vertices[1].tex.y() },
 				colorT };
 
 			mirrorVertices[1] = {
-				{ mVertices[1].pos.x(), mVertices[1].pos.y() + h },
-				{ mVertices[1].tex.x(), mVertices[0].tex.y() },
+				{ vertices[1].pos.x(), vertices[1].pos.y() + h },
+				{ vertices[1].tex.x(), vertices[0].tex.y() },
 				colorB };
 
 			mirrorVertices[2] = {
-				{ mVertices[2].pos.x(), mVertices[2].pos.y() + h },
-				{ mVertices[2].tex.x(), mVertices[3].tex.y() },
+				{ vertices[2].pos.x(), vertices[2].pos.y() + h },
+				{ vertices[2].tex.x(), vertices[3].tex.y() },
 				colorT };
 
 			mirrorVertices[3] = {
-				{ mVertices[3].pos.x(), mVertices[3].pos.y() + h },
-				{ mVertices[3].tex.x(), mVertices[2].tex.y() },
+				{ vertices[3].pos.x(), vertices[3].pos.y() + h },
+				{ vertices[3].tex.x(), vertices[2].tex.y() },
 				colorB };
 
+			// The reflection isn't masked, but keeps the saturation
+			if (imageEffect && mSaturation != 1.0f)
+				Renderer::setImageEffect(0, 0, 0, 0, 0, mSaturation);
+
 			Renderer::drawTriangleStrips(&mirrorVertices[0], 4);
+
+			if (imageEffect && mSaturation != 1.0f)
+				Renderer::resetImageEffect();
 		}
 
 		GuiComponent::renderChildren(trans);
@@ -691,6 +772,9 @@ void ImageComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 
 		if (elem->has("gradientType"))
 			setColorGradientHorizontal(elem->get<std::string>("gradientType").compare("horizontal"));
+
+		if (elem->has("saturation"))
+			setSaturation(elem->get<float>("saturation"));
 		
 		if (elem->has("reflexion"))
 			mReflection = elem->get<Vector2f>("reflexion");
@@ -867,6 +951,8 @@ ThemeData::ThemeElement::Property ImageComponent::getProperty(const std::string
 		return mReflection;
 	else if (name == "roundCorners")
 		return mRoundCorners;
+	else if (name == "saturation")
+		return mSaturation;
 	else if (name == "path")
 		return mPath;
 	else if (name == "padding")
@@ -900,6 +986,8 @@ void ImageComponent::setProperty(const std::string name, const ThemeData::ThemeE
 		mReflection = value.v;
 	else if (name == "roundCorners" && value.type == ThemeData::ThemeElement::Property::PropertyType::Float)
 		setRoundCorners(value.f);
+	else if (name == "saturation" && value.type == ThemeData::ThemeElement::Property::PropertyType::Float)
+		setSaturation(value.f);
 	else if (name == "padding" && value.type == ThemeData::ThemeElement::Property::PropertyType::Rect)
 		setPadding(value.r);
 	else if (name == "path" && value.type == ThemeData::ThemeElement::Property::PropertyType::String)
@@ -919,4 +1007,13 @@ void ImageComponent::setRoundCorners(float value)
 		
 	mRoundCorners = value; 
 	updateRoundCorners();
-}
\ No newline at end of file
+}
+
+void ImageComponent::setSaturation(float value)
+{
+	if (mSaturation == value)
+		return;
+
+	mSaturation = value;
+	invalidateContent();
+}
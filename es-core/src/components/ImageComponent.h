@@ -37,6 +37,10 @@ public:
 	//Use an already existing texture.
 	void setImage(const std::shared_ptr<TextureResource>& texture);
 
+	// Queues the loading of an image this component will likely display soon, with the same texture settings as setImage.
+	// Keep the returned texture until the image is displayed, or cancel it with TextureResource::cancelAsync.
+	std::shared_ptr<TextureResource> prefetchImage(const std::string& path);
+
 	void onSizeChanged() override;
 	void setOpacity(unsigned char opacity) override;
 
@@ -113,6 +117,9 @@ public:
 	float getRoundCorners() { return mRoundCorners; }
 	void setRoundCorners(float value);
 
+	float getSaturation() { return mSaturation; }
+	void setSaturation(float value); // 0 grayscale, 1 unchanged. Ignored by renderers without shaders
+
 	virtual void onShow() override;
 	virtual void onHide() override;
 	virtual void update(int deltaTime);
@@ -125,6 +132,9 @@ public:
 	bool isLinear() { return mLinear; }
 	void setIsLinear(bool value) { mLinear = value; }
 
+	// Keep reduced resolution levels of the texture, for images which are animated or drawn much smaller than their texture
+	void setMipmapped(bool value);
+
 	ThemeData::ThemeElement::Property getProperty(const std::string name) override;
 	void setProperty(const std::string name, const ThemeData::ThemeElement::Property& value) override;
 	void setTargetIsMax() { mTargetIsMax = true; }
@@ -178,11 +188,14 @@ private:
 	Alignment mVerticalAlignment;
 
 	float			mRoundCorners;
+	Vector4f		mRoundCornerRect;
+	float			mSaturation;
 	
 	std::shared_ptr<IPlaylist> mPlaylist;
 	float mPlaylistTimer;
 
 	bool mLinear;
+	bool mMipmapped;
 
 	std::vector<Renderer::Vertex>	mRoundCornerStencil;
 
@@ -70,6 +70,7 @@ protected:
 	using IList<ImageGridData, T>::mCursor;
 	using IList<ImageGridData, T>::Entry;
 	using IList<ImageGridData, T>::mWindow;
+	using IList<ImageGridData, T>::loadEntry;
 
 public:
 	using IList<ImageGridData, T>::size;
@@ -79,6 +80,7 @@ public:
 	ImageGridComponent(Window* window);
 
 	void add(const std::string& name, const std::string& imagePath, const std::string& videoPath, const std::string& marqueePath, bool favorite, bool cheevos, bool folder, bool virtualFolder, const T& obj);
+	void addUnloaded(bool favorite, bool folder, const T& obj); // name, paths and cheevos are given by the entry loader
 	
 	void setImage(const std::string& imagePath, const T& obj);
 	std::string getImage(const T& obj);
@@ -238,13 +240,27 @@ void ImageGridComponent<T>::add(const std::string& name, const std::string& imag
 	mEntriesDirty = true;
 }
 
+template<typename T>
+void ImageGridComponent<T>::addUnloaded(bool favorite, bool folder, const T& obj)
+{
+	typename IList<ImageGridData, T>::Entry entry;
+	entry.object = obj;
+	entry.data.favorite = favorite;
+	entry.data.cheevos = false;
+	entry.data.folder = folder;
+	entry.data.virtualFolder = false;
+
+	static_cast<IList< ImageGridData, T >*>(this)->addUnloaded(entry);
+	mEntriesDirty = true;
+}
+
 template<typename T>
 std::string ImageGridComponent<T>::getImage(const T& obj)
 {
 	IList<ImageGridData, T>* list = static_cast<IList< ImageGridData, T >*>(this);
 	auto entry = list->findEntry(obj);
 	if (entry != list->end())
-		return (*entry).data.texturePath;
+		return loadEntry(entry - mEntries.begin()).data.texturePath;
 
 	return "";
 }
@@ -256,7 +272,7 @@ void ImageGridComponent<T>::setImage(const std::string& imagePath, const T& obj)
 	auto entry = list->findEntry(obj);
 	if (entry != list->end())
 	{
-		(*entry).data.texturePath = imagePath;
+		loadEntry(entry - mEntries.begin()).data.texturePath = imagePath;
 		mEntriesDirty = true;
 	}
 }
@@ -334,8 +350,13 @@ void ImageGridComponent<T>::update(int deltaTime)
 {
 	GuiComponent::update(deltaTime);
 
+	const bool scrollbarVisible = mScrollbar.isVisible();
 	mScrollbar.update(deltaTime);
 
+	// The scrollbar is not a child : its fade has to be drawn at the frame rate
+	if (mScrollbar.isFading() || mScrollbar.isVisible() != scrollbarVisible)
+		GuiComponent::invalidateContent();
+
 	listUpdate(deltaTime);
 	
 	for(auto it = mTiles.begin(); it != mTiles.end(); it++)
@@ -1079,12 +1100,15 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 	{		
 		tile->setVisible(true);
 
-		std::string name = mEntries.at(imgPos).name;
-		std::string imagePath = mEntries.at(imgPos).data.texturePath;
-		std::string marqueePath = mEntries.at(imgPos).data.marqueePath;
+		// Only the entries of the tiles are loaded, tiles are recycled as the grid scrolls
+		typename IList<ImageGridData, T>::Entry& entry = loadEntry(imgPos);
+
+		std::string name = entry.name;
+		std::string imagePath = entry.data.texturePath;
+		std::string marqueePath = entry.data.marqueePath;
 
 		// Label
-		if (!mEntries.at(imgPos).data.favorite || tile->hasFavoriteMedia())
+		if (!entry.data.favorite || tile->hasFavoriteMedia())
 		{			
 			// Remove favorite text glyph
 			if (Utils::String::startsWith(name, _U("\uF006 ")))
@@ -1100,7 +1124,7 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 		// Image
 		if (ResourceManager::getInstance()->fileExists(imagePath))
 		{
-			if (mEntries.at(imgPos).data.virtualFolder)
+			if (entry.data.virtualFolder)
 			{
 				tile->setLabel("");
 
@@ -1121,7 +1145,7 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 		}
 		else if (mImageSource == MARQUEEORTEXT)
 			tile->setImage("");
-		else if (mEntries.at(imgPos).data.folder)
+		else if (entry.data.folder)
 			tile->setImage(mDefaultFolderTexture, mDefaultFolderTexture == ":/folder.svg");
 		else
 		{
@@ -1146,13 +1170,13 @@ void ImageGridComponent<T>::updateTileAtPos(int tilePos, int imgPos, bool allowA
 			}
 		}
 
-		tile->setFavorite(mEntries.at(imgPos).data.favorite);
-		tile->setCheevos(mEntries.at(imgPos).data.cheevos);
+		tile->setFavorite(entry.data.favorite);
+		tile->setCheevos(entry.data.cheevos);
 
 		// Video
 		if (mAllowVideo && imgPos == mCursor)
 		{			
-			std::string videoPath = mEntries.at(imgPos).data.videoPath;
+			std::string videoPath = entry.data.videoPath;
 
 			if (!videoPath.empty() && ResourceManager::getInstance()->fileExists(videoPath))
 				tile->setVideo(videoPath, mVideoDelay);
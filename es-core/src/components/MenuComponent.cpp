@@ -20,6 +20,9 @@ MenuComponent::MenuComponent(Window* window,
 	addChild(&mBackground);
 	addChild(&mGrid);
 
+	// Menus are mostly static : opening and closing animations only move the cached picture
+	setCacheAsBitmap(true);
+
 	mGrid.setZIndex(10);
 
 	mBackground.setImagePath(theme->Background.path);
@@ -22,8 +22,16 @@ void NinePatchComponent::setOpacity(unsigned char opacity)
 	if (mOpacity == opacity)
 		return;
 
+	// Cached : the opacity is applied to the picture
+	if (isCacheAsBitmap())
+	{
+		GuiComponent::setOpacity(opacity);
+		return;
+	}
+
 	mOpacity = opacity;
 	updateColors();
+	invalidateContent();
 }
 
 NinePatchComponent::~NinePatchComponent()
@@ -44,6 +52,8 @@ void NinePatchComponent::update(int deltaTime)
 		mTimer += deltaTime;
 		if (mTimer >= 2 * mAnimateTiming)
 			mTimer = 0;
+
+		invalidateContent();
 	}
 }
 
@@ -52,7 +62,7 @@ void NinePatchComponent::updateColors()
 	if (mVertices == nullptr)
 		return;
 
-	float opacity = mOpacity / 255.0;
+	float opacity = isCacheAsBitmap() ? 1.0 : mOpacity / 255.0;
 
 	unsigned int e = mEdgeColor;
 	unsigned int c = mCenterColor;
@@ -193,7 +203,18 @@ void NinePatchComponent::render(const Transform4x4f& parentTrans)
 		}
 
 		Renderer::setMatrix(trans);
-		Renderer::drawTriangleStrips(&mVertices[0], 6 * 9);
+
+		if (mTexture->isAtlased())
+		{
+			Renderer::Vertex vertices[6 * 9];
+			for (int i = 0; i < 6 * 9; i++)
+				vertices[i] = mVertices[i];
+
+			mTexture->mapTextureCoords(vertices, 6 * 9);
+			Renderer::drawTriangleStrips(&vertices[0], 6 * 9);
+		}
+		else
+			Renderer::drawTriangleStrips(&mVertices[0], 6 * 9);
 
 		if (mAnimateTiming > 0)
 			updateColors();
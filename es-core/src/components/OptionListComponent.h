@@ -280,6 +280,9 @@ public:
 	{
 		if(input.value != 0)
 		{
+			if (config->isMappedTo(BUTTON_OK, input) || (!mMultiSelect && (config->isMappedLike("left", input) || config->isMappedLike("right", input))))
+				populate();
+
 			if(config->isMappedTo(BUTTON_OK, input))
 			{
 				if (mEntries.size() > 0)
@@ -512,8 +515,50 @@ public:
 		mAddRowCallback = callback;
 	}
 
+	// Single selection lists with expensive choices : until the list is opened or changed, it only holds the current value.
+	// populate adds the choices then, with the same add calls as an eager list
+	void setLazyPopulate(const std::string& selectedName, const T& selectedObject, const std::function<void()>& populate)
+	{
+		assert(mMultiSelect == false);
+
+		mEntries.clear();
+		add(selectedName, selectedObject, true);
+
+		mLazyPopulate = populate;
+	}
+
 private:	
 	std::function<void(T& data, ComponentListRow& row)> mAddRowCallback;
+	std::function<void()> mLazyPopulate;
+
+	void populate()
+	{
+		if (mLazyPopulate == nullptr)
+			return;
+
+		auto populateFunc = mLazyPopulate;
+		mLazyPopulate = nullptr;
+
+		OptionListData current = mEntries.at(getSelectedId());
+
+		// Filling the list is not a selection change
+		auto selectedChangedCallback = mSelectedChangedCallback;
+		mSelectedChangedCallback = nullptr;
+
+		mEntries.clear();
+		populateFunc();
+
+		// The current value may not be one of the choices anymore, it's kept
+		if (!hasSelection())
+		{
+			current.group = "";
+			mEntries.insert(mEntries.begin(), current);
+			onSelectedChanged();
+		}
+
+		firstSelected = current.object;
+		mSelectedChangedCallback = selectedChangedCallback;
+	}
 
 	unsigned int getSelectedId()
 	{
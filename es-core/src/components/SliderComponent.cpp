@@ -130,6 +130,9 @@ void SliderComponent::onSizeChanged()
 
 void SliderComponent::onValueChanged()
 {
+	// The knob is not a child
+	invalidateContent();
+
 	// update suffix textcache
 	if(mFont)
 	{
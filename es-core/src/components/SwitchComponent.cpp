@@ -22,6 +22,7 @@ SwitchComponent::SwitchComponent(Window* window, bool state) : GuiComponent(wind
 void SwitchComponent::setColor(unsigned int color) 
 {
 	mImage.setColorShift(color);
+	invalidateContent();
 }
 
 void SwitchComponent::onSizeChanged()
@@ -97,6 +98,7 @@ void SwitchComponent::onStateChanged()
 {
 	auto theme = ThemeData::getMenuTheme();
 	mImage.setImage(mState ? theme->Icons.on : theme->Icons.off);
+	invalidateContent(); // The image is not a child
 
 	if (mOnChangedCallback != nullptr)
 		mOnChangedCallback();
@@ -81,11 +81,17 @@ void TextComponent::setColor(unsigned int color)
 //  Set the color of the background box
 void TextComponent::setBackgroundColor(unsigned int color)
 {
+	if (mBgColor != color)
+		invalidateContent();
+
 	mBgColor = color;
 }
 
 void TextComponent::setRenderBackground(bool render)
 {
+	if (mRenderBackground != render)
+		invalidateContent();
+
 	mRenderBackground = render;
 }
 
@@ -95,6 +101,13 @@ void TextComponent::setOpacity(unsigned char opacity)
 	if (opacity == mOpacity)
 		return;
 
+	// Cached : the opacity is applied to the picture, the text color doesn't change
+	if (isCacheAsBitmap())
+	{
+		GuiComponent::setOpacity(opacity);
+		return;
+	}
+
 	mOpacity = opacity;
 	onColorChanged();
 }
@@ -332,6 +345,8 @@ void TextComponent::render(const Transform4x4f& parentTrans)
 
 void TextComponent::onTextChanged()
 {
+	invalidateContent();
+
 	mTextLength = -1;
 	mTextCache = nullptr;
 
@@ -368,7 +383,7 @@ void TextComponent::buildTextCache()
 		addAbbrev = newline != std::string::npos;
 	}
 
-	auto color = mColor & 0xFFFFFF00 | (unsigned char)((mColor & 0xFF) * (mOpacity / 255.0));
+	auto color = mColor & 0xFFFFFF00 | (unsigned char)((mColor & 0xFF) * (isCacheAsBitmap() ? 1.0 : mOpacity / 255.0));
 
 	Vector2f size = f->sizeText(text);
 	if (!isMultiline)
@@ -399,6 +414,16 @@ void TextComponent::update(int deltaTime)
 {
 	GuiComponent::update(deltaTime);
 
+	const int marqueeOffset = mMarqueeOffset;
+	const int marqueeOffset2 = mMarqueeOffset2;
+	updateMarquee(deltaTime);
+
+	if (mMarqueeOffset != marqueeOffset || mMarqueeOffset2 != marqueeOffset2)
+		invalidateContent();
+}
+
+void TextComponent::updateMarquee(int deltaTime)
+{
 	if (!mShowing)
 	{
 		mMarqueeTime = 0;
@@ -508,9 +533,11 @@ void TextComponent::onShow()
 
 void TextComponent::onColorChanged()
 {
+	invalidateContent();
+
 	if(mTextCache)
 	{
-		auto color = mColor & 0xFFFFFF00 | (unsigned char)((mColor & 0xFF) * (mOpacity / 255.0));
+		auto color = mColor & 0xFFFFFF00 | (unsigned char)((mColor & 0xFF) * (isCacheAsBitmap() ? 1.0 : mOpacity / 255.0));
 		mTextCache->setColor(color);
 	}
 }
@@ -85,6 +85,7 @@ private:
 	void renderGlow(const Transform4x4f& parentTrans, float yOff, float xOff);
 
 	void onColorChanged();
+	void updateMarquee(int deltaTime);
 
 	unsigned int mColor;
 	unsigned int mBgColor;
@@ -35,6 +35,7 @@ void TextEditComponent::onFocusGained()
 {
 	mFocused = true;
 	mBox.setImagePath(ThemeData::getMenuTheme()->Icons.textinput_ninepatch_active);	
+	invalidateContent();
 
 	mWindow->postToUiThread([this]() { startEditing(); });
 }
@@ -43,6 +44,7 @@ void TextEditComponent::onFocusLost()
 {
 	mFocused = false;
 	mBox.setImagePath(ThemeData::getMenuTheme()->Icons.textinput_ninepatch);
+	invalidateContent();
 	
 	mWindow->postToUiThread([this]() { stopEditing(); });
 }
@@ -116,6 +118,7 @@ void TextEditComponent::startEditing()
 	}
 
 	mEditing = true;
+	invalidateContent();
 	updateHelpPrompts();
 }
 
@@ -127,6 +130,7 @@ void TextEditComponent::stopEditing()
 	SDL_StopTextInput();
 	mEditing = false;
 	mDeferTextInputStart = false;
+	invalidateContent();
 	updateHelpPrompts();
 }
 
@@ -236,10 +240,15 @@ void TextEditComponent::update(int deltaTime)
 		}
 	}
 
+	const bool cursorVisible = mBlinkTime < BLINKTIME / 2;
+
 	mBlinkTime += deltaTime;
 	if (mBlinkTime >= BLINKTIME)
 		mBlinkTime = 0;
 
+	if (mEditing && cursorVisible != (mBlinkTime < BLINKTIME / 2))
+		invalidateContent();
+
 	updateCursorRepeat(deltaTime);
 	GuiComponent::update(deltaTime);
 }
@@ -275,6 +284,8 @@ void TextEditComponent::setCursor(size_t pos)
 
 void TextEditComponent::onTextChanged()
 {
+	invalidateContent();
+
 	std::string wrappedText = (isMultiline() ? mFont->wrapText(mText, getTextAreaSize().x()) : mText);
 	mTextCache = std::unique_ptr<TextCache>(mFont->buildTextCache(wrappedText, 0, 0, (ThemeData::getMenuTheme()->Text.color & 0xFFFFFF00) | getOpacity()));
 	
@@ -284,6 +295,8 @@ void TextEditComponent::onTextChanged()
 
 void TextEditComponent::onCursorChanged()
 {
+	invalidateContent();
+
 	if(isMultiline())
 	{
 		Vector2f textSize = mFont->getWrappedTextCursorOffset(mText, getTextAreaSize().x(), mCursor); 
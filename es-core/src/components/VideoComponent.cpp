@@ -359,18 +359,21 @@ void VideoComponent::applyTheme(const std::shared_ptr<ThemeData>& theme, const s
 	{
 		Vector2f denormalized = elem->get<Vector2f>("offset") * screenScale;
 		mScreenOffset = denormalized;
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("offsetX"))
 	{
 		float denormalized = elem->get<float>("offsetX") * screenScale.x();
 		mScreenOffset = Vector2f(denormalized, mScreenOffset.y());
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("offsetY"))
 	{
 		float denormalized = elem->get<float>("offsetY") * scale.y();
 		mScreenOffset = Vector2f(mScreenOffset.x(), denormalized);
+		mTransformDirty = true;
 	}
 
 	if (properties & POSITION && elem->has("clipRect"))
@@ -470,6 +473,10 @@ void VideoComponent::update(int deltaTime)
 {
 	manageState();
 
+	// New frames are decoded all the time
+	if (mIsPlaying || mIsWaitingForVideoToStart)
+		invalidateContent();
+
 	if (mIsPlaying)
 	{
 		// If the video start is delayed and there is less than the fade time then set the image fade
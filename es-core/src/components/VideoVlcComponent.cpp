@@ -128,6 +128,9 @@ void VideoVlcComponent::onVideoStarted()
 
 void VideoVlcComponent::resize()
 {
+	// mSize is written directly
+	mTransformDirty = true;
+
 	if(!mTexture)
 		return;
 
@@ -353,6 +356,8 @@ void VideoVlcComponent::render(const Transform4x4f& parentTrans)
 			Renderer::pushClipRect(pos, size);
 		}
 
+		const bool imageEffect = mRoundCorners > 0 && Renderer::isImageEffectSupported();
+
 		if (mRoundCorners > 0)
 		{
 			float x = 0;
@@ -369,15 +374,22 @@ void VideoVlcComponent::render(const Transform4x4f& parentTrans)
 			}
 			
 			float radius = Math::max(size_x, size_y) * mRoundCorners;
-			Renderer::enableRoundCornerStencil(x, y, size_x, size_y, radius);
 
-			mTexture->bind();
+			if (imageEffect)
+				Renderer::setImageEffect(x, y, size_x, size_y, radius);
+			else
+			{
+				Renderer::enableRoundCornerStencil(x, y, size_x, size_y, radius);
+				mTexture->bind();
+			}
 		}
 
 		// Render it
 		Renderer::drawTriangleStrips(&vertices[0], 4);
 
-		if (mRoundCorners > 0)
+		if (imageEffect)
+			Renderer::resetImageEffect();
+		else if (mRoundCorners > 0)
 			Renderer::disableStencil();
 
 		if (mTargetIsMin)
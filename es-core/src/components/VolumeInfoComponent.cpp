@@ -75,6 +75,9 @@ void VolumeInfoComponent::update(int deltaTime)
 	if (mDisplayTime >= 0)
 	{
 		mDisplayTime += deltaTime;
+		if (mDisplayTime > VISIBLE_TIME)
+			invalidateContent(); // Fading out
+
 		if (mDisplayTime > VISIBLE_TIME + FADE_TIME)
 		{
 			mDisplayTime = -1;
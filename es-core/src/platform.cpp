@@ -10,6 +10,7 @@
 #include "Window.h"
 #include "utils/FileSystemUtil.h"
 #include "utils/StringUtil.h"
+#include "utils/ProviderCache.h"
 #include "Log.h"
 #include "Scripting.h"
 
@@ -393,6 +394,12 @@ std::string getShOutput(const std::string& mStr)
     pclose(pipe);
     return result;
 }
+
+std::string getCachedShOutput(const std::string& mStr, int ttlSeconds)
+{
+	auto output = Utils::ProviderCache::get(mStr, ttlSeconds, [mStr] { return std::vector<std::string> { getShOutput(mStr) }; });
+	return output.size() > 0 ? output[0] : "";
+}
 /* emuelec >*/
 #endif
 
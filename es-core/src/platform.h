@@ -47,6 +47,7 @@ std::string queryIPAdress();
 
 #ifdef _ENABLEEMUELEC
 std::string getShOutput(const std::string& mStr); /* < emuelec */
+std::string getCachedShOutput(const std::string& mStr, int ttlSeconds); // reuses the output of the command for ttlSeconds
 #endif
 std::string getArchString();
 
@@ -1,3 +1,5 @@
+#if !defined(USE_HEADLESS_RENDERER)
+
 #include "GlExtensions.h"
 #include <SDL.h>
 #include "Log.h"
@@ -8,6 +10,7 @@ namespace glext
 	PFNGLCOMPILESHADERPROC glCompileShader = nullptr;
 	PFNGLCREATEPROGRAMPROC glCreateProgram = nullptr;
 	PFNGLGENBUFFERSPROC	glGenBuffers = nullptr;		
+	PFNGLDELETEBUFFERSPROC glDeleteBuffers = nullptr;
 	PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
 	PFNGLSHADERSOURCEPROC glShaderSource = nullptr;
 	PFNGLGETSHADERIVPROC glGetShaderiv = nullptr;
@@ -18,6 +21,8 @@ namespace glext
 	PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = nullptr;
 	PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
 	PFNGLUNIFORM1IPROC glUniform1i = nullptr;
+	PFNGLUNIFORM1FPROC glUniform1f = nullptr;
+	PFNGLUNIFORM4FPROC glUniform4f = nullptr;
 	PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation = nullptr;
 	PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation = nullptr;
 	PFNGLBUFFERDATAPROC glBufferData = nullptr;
@@ -29,6 +34,13 @@ namespace glext
 	PFNGLCREATESHADERPROC glCreateShader = nullptr;
 	PFNGLACTIVETEXTUREPROC glActiveTexture_ = nullptr;
 
+	PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate = nullptr;
+	PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers = nullptr;
+	PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers = nullptr;
+	PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer = nullptr;
+	PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D = nullptr;
+	PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus = nullptr;
+
 	void* _glProcAddress(const char *proc)
 	{
 		void* ret = SDL_GL_GetProcAddress(proc);
@@ -68,6 +80,7 @@ namespace glext
 		glCompileShader = (PFNGLCOMPILESHADERPROC)_glProcAddress("glCompileShader");
 		glCreateProgram = (PFNGLCREATEPROGRAMOBJECTARBPROC)_glProcAddress("glCreateProgram");
 		glGenBuffers = (PFNGLGENBUFFERSPROC)_glProcAddress("glGenBuffers");
+		glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)_glProcAddress("glDeleteBuffers");
 		glBindBuffer = (PFNGLBINDBUFFERPROC)_glProcAddress("glBindBuffer");
 		glShaderSource = (PFNGLSHADERSOURCEPROC)_glProcAddress("glShaderSource");
 		glGetShaderiv = (PFNGLGETSHADERIVPROC)_glProcAddress("glGetShaderiv");
@@ -78,6 +91,8 @@ namespace glext
 		glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)_glProcAddress("glGetProgramInfoLog");
 		glUseProgram = (PFNGLUSEPROGRAMPROC)_glProcAddress("glUseProgram");
 		glUniform1i = (PFNGLUNIFORM1IPROC)_glProcAddress("glUniform1i");
+		glUniform1f = (PFNGLUNIFORM1FPROC)_glProcAddress("glUniform1f");
+		glUniform4f = (PFNGLUNIFORM4FPROC)_glProcAddress("glUniform4f");
 		glGetUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC)_glProcAddress("glGetUniformLocation");
 		glGetAttribLocation = (PFNGLGETATTRIBLOCATIONPROC)_glProcAddress("glGetAttribLocation");
 		glBufferData = (PFNGLBUFFERDATAPROC)_glProcAddress("glBufferData");
@@ -88,11 +103,22 @@ namespace glext
 		glUniformMatrix4fv = (PFNGLUNIFORMMATRIX4FVPROC)_glProcAddress("glUniformMatrix4fv");
 		glActiveTexture_ = (PFNGLACTIVETEXTUREPROC)_glProcAddress("glActiveTexture");
 
+		// Optional : without them, render targets are not supported
+		if (SDL_GL_ExtensionSupported("GL_ARB_framebuffer_object"))
+		{
+			glBlendFuncSeparate = (PFNGLBLENDFUNCSEPARATEPROC)_glProcAddress("glBlendFuncSeparate");
+			glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)_glProcAddress("glGenFramebuffers");
+			glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)_glProcAddress("glDeleteFramebuffers");
+			glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)_glProcAddress("glBindFramebuffer");
+			glFramebufferTexture2D = (PFNGLFRAMEBUFFERTEXTURE2DPROC)_glProcAddress("glFramebufferTexture2D");
+			glCheckFramebufferStatus = (PFNGLCHECKFRAMEBUFFERSTATUSPROC)_glProcAddress("glCheckFramebufferStatus");
+		}
+
 		return 
-			glCreateShader != nullptr && glCompileShader != nullptr && glCreateProgram != nullptr && glGenBuffers != nullptr && 
+			glCreateShader != nullptr && glCompileShader != nullptr && glCreateProgram != nullptr && glGenBuffers != nullptr && glDeleteBuffers != nullptr && 
 			glBindBuffer != nullptr && glGetShaderiv != nullptr && glGetShaderInfoLog != nullptr && glAttachShader != nullptr &&
 			glLinkProgram != nullptr && glGetProgramiv != nullptr && glGetProgramInfoLog != nullptr && glUseProgram != nullptr &&
-			glUniform1i != nullptr && glGetUniformLocation != nullptr && glGetAttribLocation != nullptr && glBufferData != nullptr &&
+			glUniform1i != nullptr && glUniform1f != nullptr && glUniform4f != nullptr && glGetUniformLocation != nullptr && glGetAttribLocation != nullptr && glBufferData != nullptr &&
 			glVertexAttribPointer != nullptr && glBufferData != nullptr && glBufferSubData != nullptr && glVertexAttribPointer != nullptr && glEnableVertexAttribArray != nullptr &&
 			glDisableVertexAttribArray != nullptr && glUniformMatrix4fv != nullptr && glActiveTexture_ != nullptr;
 	}
@@ -110,3 +136,5 @@ void _GLCheckError(const char* _funcName)
 		LOG(LogError) << "GL error: " << _funcName << " failed with error code: " << errorCode;
 }
 #endif
+
+#endif // !USE_HEADLESS_RENDERER
@@ -15,6 +15,7 @@ namespace glext
 	extern PFNGLCOMPILESHADERPROC glCompileShader;
 	extern PFNGLCREATEPROGRAMPROC glCreateProgram;
 	extern PFNGLGENBUFFERSPROC	glGenBuffers;
+	extern PFNGLDELETEBUFFERSPROC glDeleteBuffers;
 	extern PFNGLBINDBUFFERPROC glBindBuffer;
 	extern PFNGLSHADERSOURCEPROC glShaderSource;
 	extern PFNGLGETSHADERIVPROC glGetShaderiv;
@@ -25,6 +26,8 @@ namespace glext
 	extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
 	extern PFNGLUSEPROGRAMPROC glUseProgram;
 	extern PFNGLUNIFORM1IPROC glUniform1i;
+	extern PFNGLUNIFORM1FPROC glUniform1f;
+	extern PFNGLUNIFORM4FPROC glUniform4f;
 	extern PFNGLGETUNIFORMLOCATIONPROC glGetUniformLocation;
 	extern PFNGLGETATTRIBLOCATIONPROC glGetAttribLocation;
 	extern PFNGLBUFFERDATAPROC glBufferData;
@@ -35,6 +38,14 @@ namespace glext
 	extern PFNGLUNIFORMMATRIX4FVPROC glUniformMatrix4fv;
 	extern PFNGLCREATESHADERPROC glCreateShader;
 	extern PFNGLACTIVETEXTUREPROC glActiveTexture_;
+
+	// Render targets, only loaded with GL_ARB_framebuffer_object
+	extern PFNGLBLENDFUNCSEPARATEPROC glBlendFuncSeparate;
+	extern PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers;
+	extern PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+	extern PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+	extern PFNGLFRAMEBUFFERTEXTURE2DPROC glFramebufferTexture2D;
+	extern PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus;
 };
 
 using namespace glext;
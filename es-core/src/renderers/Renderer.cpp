@@ -27,6 +27,21 @@ namespace Renderer
 
 	static Vector2i			sdlWindowPosition = Vector2i(SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED);
 
+	// Projection and viewport of the window, restored when the last render target is popped
+	static Transform4x4f    screenProjection   = Transform4x4f::Identity();
+	static Rect             screenViewport     = Rect(0, 0, 0, 0);
+
+	struct RenderTargetState
+	{
+		unsigned int     target;
+		int              width;
+		int              height;
+		std::stack<Rect> clipStack;       // Clip rects of what was drawing before the target was pushed
+		std::stack<Rect> nativeClipStack;
+	};
+
+	static std::vector<RenderTargetState> renderTargetStack;
+
 	static void setIcon()
 	{
 		size_t                     width   = 0;
@@ -67,6 +82,11 @@ namespace Renderer
 	{
 		LOG(LogInfo) << "Creating window...";
 
+#if defined(USE_HEADLESS_RENDERER)
+		// No display : SDL only provides the events and timers, unless another video driver is forced
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+#endif
+
 		if(SDL_Init(SDL_INIT_VIDEO) != 0)
 		{
 			LOG(LogError) << "Error initializing SDL!\n	" << SDL_GetError();
@@ -262,6 +282,9 @@ namespace Renderer
 			break;
 		}
 
+		screenViewport = viewport;
+		screenProjection = projection;
+
 		setViewport(viewport);
 		setProjection(projection);
 		swapBuffers();
@@ -283,7 +306,8 @@ namespace Renderer
 		if(box.w == 0) box.w = screenWidth  - box.x;
 		if(box.h == 0) box.h = screenHeight - box.y;
 
-		switch(screenRotate)
+		// Render targets are not rotated nor offset
+		switch(renderTargetStack.empty() ? screenRotate : -1)
 		{
 			case 0: { box = Rect(screenOffsetX + box.x,                       screenOffsetY + box.y,                        box.w, box.h); } break;
 			case 1: { box = Rect(windowWidth - screenOffsetY - box.y - box.h, screenOffsetX + box.x,                        box.h, box.w); } break;
@@ -337,6 +361,70 @@ namespace Renderer
 
 	} // popClipRect
 
+	bool pushRenderTarget(const unsigned int _target, const int _width, const int _height)
+	{
+		if (!bindRenderTarget(_target, true))
+		{
+			// Back to what was drawing
+			bindRenderTarget(renderTargetStack.empty() ? 0 : renderTargetStack.back().target, false);
+			return false;
+		}
+
+		RenderTargetState state;
+		state.target = _target;
+		state.width = _width;
+		state.height = _height;
+		std::swap(state.clipStack, clipStack);
+		std::swap(state.nativeClipStack, nativeClipStack);
+		renderTargetStack.push_back(state);
+
+		Transform4x4f projection = Transform4x4f::Identity();
+		projection.orthoProjection(0, _width, _height, 0, -1.0, 1.0);
+
+		setScissor(Rect(0, 0, 0, 0));
+		setViewport(Rect(0, 0, _width, _height));
+		setProjection(projection);
+
+		getCurrentFrameStats().renderTargetUpdates++;
+		return true;
+
+	} // pushRenderTarget
+
+	void popRenderTarget()
+	{
+		if (renderTargetStack.empty())
+		{
+			LOG(LogError) << "Tried to popRenderTarget while the stack was empty!";
+			return;
+		}
+
+		std::swap(clipStack, renderTargetStack.back().clipStack);
+		std::swap(nativeClipStack, renderTargetStack.back().nativeClipStack);
+		renderTargetStack.pop_back();
+
+		if (renderTargetStack.empty())
+		{
+			bindRenderTarget(0, false);
+			setViewport(screenViewport);
+			setProjection(screenProjection);
+		}
+		else
+		{
+			const RenderTargetState& state = renderTargetStack.back();
+
+			Transform4x4f projection = Transform4x4f::Identity();
+			projection.orthoProjection(0, state.width, state.height, 0, -1.0, 1.0);
+
+			bindRenderTarget(state.target, false);
+			setViewport(Rect(0, 0, state.width, state.height));
+			setProjection(projection);
+		}
+
+		if (clipStack.empty()) setScissor(Rect(0, 0, 0, 0));
+		else                   setScissor(clipStack.top());
+
+	} // popRenderTarget
+
 	void drawRect(const float _x, const float _y, const float _w, const float _h, const unsigned int _color, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
 		drawRect(_x, _y, _w, _h, _color, _color, true, _srcBlendFactor, _dstBlendFactor);
@@ -405,6 +493,9 @@ namespace Renderer
 	bool isVisibleOnScreen(float x, float y, float w, float h)
 	{
 		Rect screen = Rect(0, 0, Renderer::getScreenWidth(), Renderer::getScreenHeight());
+		if (!renderTargetStack.empty())
+			screen = Rect(0, 0, renderTargetStack.back().width, renderTargetStack.back().height);
+
 		Rect box = Rect(x, y, w, h);
 
 		if (w > 0 && x + w <= 0)
@@ -510,5 +601,55 @@ namespace Renderer
 		setStencil(vertex.data(), vertex.size());
 	}
 
+	static int textureUploadTime  = 0; // microseconds spent uploading textures during the current frame
+	static int textureUploadCount = 0;
+
+	bool isTextureUploadAllowed()
+	{
+		// Always allow one upload per frame, so loading progresses whatever the budget
+		if (textureUploadCount == 0)
+			return true;
+
+		int budget = Settings::getInstance()->getInt("TextureUploadBudget");
+		return budget <= 0 || textureUploadTime < budget * 1000;
+	}
+
+	void addTextureUploadTime(const int _microseconds)
+	{
+		textureUploadTime += _microseconds;
+		textureUploadCount++;
+	}
+
+	void resetTextureUploadBudget()
+	{
+		textureUploadTime = 0;
+		textureUploadCount = 0;
+	}
+
+	static FrameStats currentFrameStats;
+	static FrameStats lastFrameStats;
+
+	const FrameStats& getFrameStats()
+	{
+		return lastFrameStats;
+	}
+
+	FrameStats& getCurrentFrameStats()
+	{
+		return currentFrameStats;
+	}
+
+	void resetFrameStats()
+	{
+		lastFrameStats = currentFrameStats;
+		currentFrameStats = FrameStats();
+	}
+
+	void addTextureUploadStats(const Texture::Type _type, const unsigned int _width, const unsigned int _height)
+	{
+		currentFrameStats.textureUploads++;
+		currentFrameStats.textureUploadBytes += _width * _height * 4;
+	}
+
 
 } // Renderer::
@@ -90,6 +90,32 @@ namespace Renderer
 	void         destroyTexture    (const unsigned int _texture);
 	void         updateTexture     (const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data);
 	void         bindTexture       (const unsigned int _texture);
+
+	// Static vertex buffers keep geometry that doesn't change in VRAM. Returns 0 if unsupported. Buffers are lost
+	// when the renderer is reinitialized : drawStaticVertexBuffer then returns false and the buffer must be recreated
+	unsigned int createStaticVertexBuffer (const Vertex* _vertices, const unsigned int _numVertices);
+	void         destroyStaticVertexBuffer(const unsigned int _buffer);
+	bool         drawStaticVertexBuffer   (const unsigned int _buffer, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
+
+	// Render targets are textures the draws can be redirected to, to keep a composition that doesn't change. createRenderTarget returns 0 if unsupported.
+	// Their pixels have premultiplied alpha. Targets are lost when the renderer is reinitialized : bindRenderTarget then returns false
+	bool         isRenderTargetSupported();
+	unsigned int createRenderTarget    (const unsigned int _width, const unsigned int _height);
+	void         destroyRenderTarget   (const unsigned int _target);
+	unsigned int getRenderTargetTexture(const unsigned int _target);
+	bool         bindRenderTarget      (const unsigned int _target, const bool _clear); // 0 binds the window
+
+	// Signed distance field textures (font atlases) : while the smoothing is not 0, textured draws rebuild the edge at 0.5 alpha,
+	// blurred by this amount of alpha at scale 1 (the renderer adjusts it to the current matrix scale)
+	bool         isDistanceFieldSupported();
+	void         setDistanceField  (const float _smoothing);
+
+	// Image effects computed per pixel by the shader renderers, for the textured draws made until resetImageEffect : a rounded rectangle
+	// mask (in the coordinates of the current matrix, replacing stencil passes) and a saturation (0 grayscale, 1 unchanged)
+	bool         isImageEffectSupported();
+	void         setImageEffect    (const float _x, const float _y, const float _width, const float _height, const float _radius, const float _saturation = 1.0f);
+	void         resetImageEffect  ();
+
 	void         drawLines         (const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
 	void         drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor = Blend::SRC_ALPHA, const Blend::Factor _dstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA);
 	void         setProjection     (const Transform4x4f& _projection);
@@ -102,6 +128,10 @@ namespace Renderer
 
 	// batocera methods
 	bool         isClippingEnabled  ();
+
+	// Draws made until popRenderTarget go to the target, in its own coordinates (0, 0 is its top left corner) and with its own clip rects
+	bool         pushRenderTarget   (const unsigned int _target, const int _width, const int _height);
+	void         popRenderTarget    ();
 	bool         isVisibleOnScreen  (float x, float y, float w, float h);
 	bool         isSmallScreen      ();
 	unsigned int mixColors(unsigned int first, unsigned int second, float percent);
@@ -118,6 +148,32 @@ namespace Renderer
 
 	void		activateWindow();
 
+	// Texture uploads are limited by a time budget (TextureUploadBudget, in ms) per frame : textures over budget are uploaded on the next frames
+	bool		isTextureUploadAllowed();
+	void		addTextureUploadTime(const int _microseconds);
+	void		resetTextureUploadBudget();
+
+	struct FrameStats
+	{
+		FrameStats() : draws(0), drawCalls(0), textureBinds(0), blendChanges(0), programSwitches(0), textureUploads(0), textureUploadBytes(0), renderTargetUpdates(0) { }
+
+		int draws;				// Draw requests made to the renderer
+		int drawCalls;			// GL draw calls issued for them, after batching
+		int textureBinds;		// State changes that reached GL, redundant ones are skipped
+		int blendChanges;
+		int programSwitches;
+		int textureUploads;		// Texture creations and updates with pixels
+		int textureUploadBytes;	// 4 bytes per pixel whatever the type, like the VRAM usage reports
+		int renderTargetUpdates;	// Render targets drawn again
+
+	}; // FrameStats
+
+	// Statistics of the last complete frame, shown with DrawFramerate
+	const FrameStats&	getFrameStats();
+	FrameStats&			getCurrentFrameStats();
+	void				resetFrameStats();
+	void				addTextureUploadStats(const Texture::Type _type, const unsigned int _width, const unsigned int _height);
+
 } // Renderer::
 
 #endif // ES_CORE_RENDERER_RENDERER_H
@@ -13,6 +13,16 @@ namespace Renderer
 {
 	static SDL_GLContext sdlContext = nullptr;
 
+	// Shadowed GL state : calls that wouldn't change anything are skipped
+	static unsigned int  boundTexture        = 0;
+	static bool          textureEnabled      = false;
+	static bool          blendEnabled        = false;
+	static GLenum        blendSrcFactor      = GL_ONE;
+	static GLenum        blendDstFactor      = GL_ZERO;
+	static bool          clientStatesEnabled = false;
+	static bool          scissorEnabled      = false;
+	static Rect          scissorRect         = Rect(0, 0, 0, 0);
+
 	static GLenum convertBlendFactor(const Blend::Factor _blendFactor)
 	{
 		switch(_blendFactor)
@@ -32,6 +42,68 @@ namespace Renderer
 
 	} // convertBlendFactor
 
+	// A new context starts with the default GL state
+	static void resetStateCache()
+	{
+		boundTexture        = 0;
+		textureEnabled      = false;
+		blendEnabled        = false;
+		blendSrcFactor      = GL_ONE;
+		blendDstFactor      = GL_ZERO;
+		clientStatesEnabled = false;
+		scissorEnabled      = false;
+		scissorRect         = Rect(0, 0, 0, 0);
+
+	} // resetStateCache
+
+	static void setTextureEnabled(const bool _enabled)
+	{
+		if (textureEnabled == _enabled)
+			return;
+
+		if (_enabled) glEnable(GL_TEXTURE_2D);
+		else          glDisable(GL_TEXTURE_2D);
+
+		textureEnabled = _enabled;
+
+	} // setTextureEnabled
+
+	// Every draw is blended : GL_BLEND stays enabled and only real blend function changes reach the driver
+	static void setBlendFunc(const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if (!blendEnabled)
+		{
+			glEnable(GL_BLEND);
+			blendEnabled = true;
+		}
+
+		const GLenum src = convertBlendFactor(_srcBlendFactor);
+		const GLenum dst = convertBlendFactor(_dstBlendFactor);
+		if (src == blendSrcFactor && dst == blendDstFactor)
+			return;
+
+		glBlendFunc(src, dst);
+		blendSrcFactor = src;
+		blendDstFactor = dst;
+
+		getCurrentFrameStats().blendChanges++;
+
+	} // setBlendFunc
+
+	// All draws use the same vertex layout : the client arrays stay enabled
+	static void enableClientStates()
+	{
+		if (clientStatesEnabled)
+			return;
+
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+
+		clientStatesEnabled = true;
+
+	} // enableClientStates
+
 	static GLenum convertTextureType(const Texture::Type _type)
 	{
 		switch(_type)
@@ -102,6 +174,8 @@ namespace Renderer
 		sdlContext = SDL_GL_CreateContext(getSDLWindow());
 		SDL_GL_MakeCurrent(getSDLWindow(), sdlContext);
 
+		resetStateCache();
+
 		glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
 		std::string glExts = (const char*)glGetString(GL_EXTENSIONS);
@@ -144,12 +218,19 @@ namespace Renderer
 			return 0;
 		}
 
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
 		return texture;
 
 	} // createTexture
 
 	void destroyTexture(const unsigned int _texture)
 	{
+		// Deleting the bound texture reverts the binding to 0
+		if (boundTexture == _texture)
+			boundTexture = 0;
+
 		glDeleteTextures(1, &_texture);
 
 	} // destroyTexture
@@ -168,25 +249,29 @@ namespace Renderer
 
 		bindTexture(0);
 
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
 	} // updateTexture
 
 	void bindTexture(const unsigned int _texture)
 	{
+		setTextureEnabled(_texture != 0);
+
+		if (boundTexture == _texture)
+			return;
+
 		glBindTexture(GL_TEXTURE_2D, _texture);
+		boundTexture = _texture;
 
-		if(_texture == 0) glDisable(GL_TEXTURE_2D);
-		else              glEnable(GL_TEXTURE_2D);
+		getCurrentFrameStats().textureBinds++;
 
 	} // bindTexture
 
 	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
-
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
+		enableClientStates();
 
 		glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos);
 		glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex);
@@ -194,22 +279,15 @@ namespace Renderer
 
 		glDrawArrays(GL_LINES, 0, _numVertices);
 
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-
-		glDisable(GL_BLEND);
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
 
 	} // drawLines
 
 	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
-
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
+		enableClientStates();
 
 		glVertexPointer(  2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].pos);
 		glTexCoordPointer(2, GL_FLOAT,         sizeof(Vertex), &_vertices[0].tex);
@@ -217,14 +295,83 @@ namespace Renderer
 
 		glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices);
 
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-
-		glDisable(GL_BLEND);
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
 
 	} // drawTriangleStrips
 
+	// No shaders : distance field textures can't be drawn, fonts keep their bitmap glyphs
+	bool isDistanceFieldSupported()
+	{
+		return false;
+
+	} // isDistanceFieldSupported
+
+	void setDistanceField(const float _smoothing)
+	{
+	} // setDistanceField
+
+	// Images keep the stencil for their round corners, and their saturation is ignored
+	bool isImageEffectSupported()
+	{
+		return false;
+
+	} // isImageEffectSupported
+
+	void setImageEffect(const float _x, const float _y, const float _width, const float _height, const float _radius, const float _saturation)
+	{
+	} // setImageEffect
+
+	void resetImageEffect()
+	{
+	} // resetImageEffect
+
+	// Client-side vertex arrays only : static buffers are not supported, callers draw their vertices directly
+	unsigned int createStaticVertexBuffer(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		return 0;
+
+	} // createStaticVertexBuffer
+
+	void destroyStaticVertexBuffer(const unsigned int _buffer)
+	{
+	} // destroyStaticVertexBuffer
+
+	bool drawStaticVertexBuffer(const unsigned int _buffer, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		return false;
+
+	} // drawStaticVertexBuffer
+
+	// Framebuffer objects are only an extension on GLES 1.0 : render targets are not supported
+	bool isRenderTargetSupported()
+	{
+		return false;
+
+	} // isRenderTargetSupported
+
+	unsigned int createRenderTarget(const unsigned int _width, const unsigned int _height)
+	{
+		return 0;
+
+	} // createRenderTarget
+
+	void destroyRenderTarget(const unsigned int _target)
+	{
+	} // destroyRenderTarget
+
+	unsigned int getRenderTargetTexture(const unsigned int _target)
+	{
+		return 0;
+
+	} // getRenderTargetTexture
+
+	bool bindRenderTarget(const unsigned int _target, const bool _clear)
+	{
+		return _target == 0;
+
+	} // bindRenderTarget
+
 	void setProjection(const Transform4x4f& _projection)
 	{
 		glMatrixMode(GL_PROJECTION);
@@ -252,13 +399,26 @@ namespace Renderer
 	{
 		if((_scissor.x == 0) && (_scissor.y == 0) && (_scissor.w == 0) && (_scissor.h == 0))
 		{
-			glDisable(GL_SCISSOR_TEST);
+			if (scissorEnabled)
+			{
+				glDisable(GL_SCISSOR_TEST);
+				scissorEnabled = false;
+			}
 		}
 		else
 		{
+			if (scissorEnabled && _scissor.x == scissorRect.x && _scissor.y == scissorRect.y && _scissor.w == scissorRect.w && _scissor.h == scissorRect.h)
+				return;
+
 			// glScissor starts at the bottom left of the window
 			glScissor(_scissor.x, getWindowHeight() - _scissor.y - _scissor.h, _scissor.w, _scissor.h);
-			glEnable(GL_SCISSOR_TEST);
+			scissorRect = _scissor;
+
+			if (!scissorEnabled)
+			{
+				glEnable(GL_SCISSOR_TEST);
+				scissorEnabled = true;
+			}
 		}
 
 	} // setScissor
@@ -286,17 +446,15 @@ namespace Renderer
 	{
 		SDL_GL_SwapWindow(getSDLWindow());
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		resetTextureUploadBudget();
+		resetFrameStats();
 
 	} // swapBuffers
 
 	void drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor));
-
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glEnableClientState(GL_COLOR_ARRAY);
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
+		enableClientStates();
 
 		glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &_vertices[0].pos);
 		glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &_vertices[0].tex);
@@ -304,16 +462,14 @@ namespace Renderer
 
 		glDrawArrays(GL_TRIANGLE_FAN, 0, _numVertices);
 
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glDisable(GL_BLEND);
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
 	}
 
 	void setStencil(const Vertex* _vertices, const unsigned int _numVertices)
 	{
-		bool tx = glIsEnabled(GL_TEXTURE_2D);
-		glDisable(GL_TEXTURE_2D);
+		bool tx = textureEnabled;
+		setTextureEnabled(false);
 
 		glClear(GL_DEPTH_BUFFER_BIT);
 		glEnable(GL_STENCIL_TEST);
@@ -333,8 +489,7 @@ namespace Renderer
 		glStencilFunc(GL_EQUAL, 0, 0xFF);
 		glStencilFunc(GL_EQUAL, 1, 0xFF);
 
-		if (tx)
-			glEnable(GL_TEXTURE_2D);
+		setTextureEnabled(tx);
 	}
 
 	void disableStencil()
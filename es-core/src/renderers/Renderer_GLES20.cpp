@@ -5,6 +5,8 @@
 #include "Log.h"
 #include "Settings.h"
 
+#include <map>
+#include <string.h>
 #include <vector>
 
 #include "GlExtensions.h"
@@ -28,70 +30,180 @@ namespace Renderer
 	static Shader  	fragmentShaderColorNoTexture;
 	static ShaderProgram    shaderProgramColorNoTexture;
 
+	// Textures holding signed distance fields (font atlases) : the edge is rebuilt at any scale in the fragment shader
+	static Shader  	fragmentShaderDistanceField;
+	static ShaderProgram    shaderProgramDistanceField;
+	static GLint            distanceFieldSmoothingUniform = -1;
+	static float            distanceFieldSmoothing = 0.0f; // At scale 1, 0 when drawing regular textures
+
+	// Images with round corners or a saturation : the mask and the color are computed per pixel, on a single quad
+	static Shader  	vertexShaderImageEffect;
+	static Shader  	fragmentShaderImageEffect;
+	static ShaderProgram    shaderProgramImageEffect;
+	static GLint            imageEffectRectUniform       = -1;
+	static GLint            imageEffectRadiusUniform     = -1;
+	static GLint            imageEffectSaturationUniform = -1;
+	static bool             imageEffectEnabled = false;
+	static float            imageEffect[6];         // x, y, width, height, radius, saturation
+
 	static GLuint        vertexBuffer     = 0;
+	static GLuint        indexBuffer      = 0;
+	static unsigned int  boundTexture     = 0;
+
+	// Consecutive triangle strips with the same texture and blending are merged into one indexed triangle list.
+	// Vertices are stored already transformed, so matrix changes don't break batches
+	#define BATCH_MAX_VERTICES	8192
+
+	// Static vertex buffers, by handle. Handles are never reused : buffers lost with a context are just unknown afterwards
+	static std::map<unsigned int, GLuint> staticVertexBuffers;
+	static unsigned int                   nextStaticVertexBuffer = 1;
+
+	// Render targets, by handle. Like static vertex buffers, handles are never reused
+	struct RenderTarget
+	{
+		GLuint       framebuffer;
+		unsigned int texture;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	static std::map<unsigned int, RenderTarget> renderTargets;
+	static unsigned int                         nextRenderTarget    = 1;
+	static unsigned int                         currentRenderTarget = 0; // 0 is the window
+	static bool                                 renderTargetsSupported = false;
+
+	static bool                  batchingEnabled = false;
+	static std::vector<Vertex>   batchVertices;
+	static std::vector<GLushort> batchIndices;
+	static Blend::Factor         batchSrcBlendFactor = Blend::SRC_ALPHA;
+	static Blend::Factor         batchDstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA;
+	static float                 batchDistanceField  = 0.0f;
+
+	// Shadowed GL state : calls that wouldn't change anything are skipped
+	static bool          blendEnabled     = false;
+	static GLenum        blendSrcFactor   = GL_ONE;
+	static GLenum        blendDstFactor   = GL_ZERO;
+	static bool          scissorEnabled   = false;
+	static Rect          scissorRect      = Rect(0, 0, 0, 0);
+	static bool          blendSeparate    = false; // Alpha is accumulated as premultiplied while drawing to a render target
+	static Transform4x4f textureProgramMatrix;   // Last u_mvp uploaded to shaderProgramColorTexture
+	static Transform4x4f noTextureProgramMatrix; // Last u_mvp uploaded to shaderProgramColorNoTexture
+	static Transform4x4f distanceFieldMatrix;    // Last u_mvp uploaded to shaderProgramDistanceField
+	static float         distanceFieldUniform = -1.0f;
+	static Transform4x4f imageEffectMatrix;      // Last u_mvp uploaded to shaderProgramImageEffect
+	static float         imageEffectUniforms[6]; // Last image effect uploaded
 
 //////////////////////////////////////////////////////////////////////////
 
 	#define SHADER_VERSION_STRING "#version 100\n"
 
 	static ShaderProgram* currentProgram = nullptr;
+
+	static void setMvpUniform(ShaderProgram* program, const Transform4x4f& matrix)
+	{
+		Transform4x4f& uploaded = (program == &shaderProgramColorTexture ? textureProgramMatrix : program == &shaderProgramDistanceField ? distanceFieldMatrix : program == &shaderProgramImageEffect ? imageEffectMatrix : noTextureProgramMatrix);
+		if (memcmp(&uploaded, &matrix, sizeof(Transform4x4f)) == 0)
+			return;
+
+		uploaded = matrix;
+		GL_CHECK_ERROR(glUniformMatrix4fv(program->mvpUniform, 1, GL_FALSE, (float*)&matrix));
+	}
 	
+	// Points the program's attributes to the buffer bound to GL_ARRAY_BUFFER
+	static void setVertexAttribPointers(ShaderProgram* program)
+	{
+		GL_CHECK_ERROR(glVertexAttribPointer(program->posAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, pos)));
+		GL_CHECK_ERROR(glVertexAttribPointer(program->colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const void*)offsetof(Vertex, col)));
+
+		if (program->texAttrib >= 0)
+			GL_CHECK_ERROR(glVertexAttribPointer(program->texAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, tex)));
+	}
+
 	static void useProgram(ShaderProgram* program)
 	{
 		if (program == currentProgram)
 		{
-			if (currentProgram == &shaderProgramColorTexture)
-				GL_CHECK_ERROR(glUniformMatrix4fv(shaderProgramColorTexture.mvpUniform, 1, GL_FALSE, (float*)&mvpMatrix));
-			else  if (currentProgram == &shaderProgramColorNoTexture)
-				GL_CHECK_ERROR(glUniformMatrix4fv(shaderProgramColorNoTexture.mvpUniform, 1, GL_FALSE, (float*)&mvpMatrix));
+			if (currentProgram != nullptr)
+				setMvpUniform(currentProgram, mvpMatrix);
 
 			return;
 		}
 
 		if (program == nullptr && currentProgram != nullptr)
 		{
-			if (currentProgram == &shaderProgramColorTexture)
-			{
-				GL_CHECK_ERROR(glDisableVertexAttribArray(shaderProgramColorTexture.posAttrib));
-				GL_CHECK_ERROR(glDisableVertexAttribArray(shaderProgramColorTexture.colAttrib));
-				GL_CHECK_ERROR(glDisableVertexAttribArray(shaderProgramColorTexture.texAttrib));
-			}
+			GL_CHECK_ERROR(glDisableVertexAttribArray(currentProgram->posAttrib));
+			GL_CHECK_ERROR(glDisableVertexAttribArray(currentProgram->colAttrib));
 
-			if (currentProgram == &shaderProgramColorNoTexture)
-			{
-				GL_CHECK_ERROR(glDisableVertexAttribArray(shaderProgramColorNoTexture.posAttrib));
-				GL_CHECK_ERROR(glDisableVertexAttribArray(shaderProgramColorNoTexture.colAttrib));
-			}
+			if (currentProgram->texAttrib >= 0)
+				GL_CHECK_ERROR(glDisableVertexAttribArray(currentProgram->texAttrib));
 		}
 
 		currentProgram = program;
 
-		if (currentProgram == &shaderProgramColorTexture)
+		if (currentProgram == nullptr)
+			return;
+
+		getCurrentFrameStats().programSwitches++;
+
+		GL_CHECK_ERROR(glUseProgram(currentProgram->id));
+		setMvpUniform(currentProgram, mvpMatrix);
+		setVertexAttribPointers(currentProgram);
+
+		GL_CHECK_ERROR(glEnableVertexAttribArray(currentProgram->posAttrib));
+		GL_CHECK_ERROR(glEnableVertexAttribArray(currentProgram->colAttrib));
+
+		if (currentProgram->texAttrib >= 0)
+			GL_CHECK_ERROR(glEnableVertexAttribArray(currentProgram->texAttrib));
+	}
+
+	// Smoothing of the distance field edges for the current matrix : scaled up text needs a sharper edge
+	static float getDistanceFieldSmoothing()
+	{
+		if (distanceFieldSmoothing <= 0.0f)
+			return 0.0f;
+
+		const float* tm = (float*)&worldViewMatrix;
+		const float scale = sqrtf(tm[0] * tm[0] + tm[1] * tm[1]);
+
+		return (scale > 0.0f ? distanceFieldSmoothing / scale : distanceFieldSmoothing);
+	}
+
+	// Selects the program for the bound texture, and uploads the distance field smoothing if that program is used
+	static void useDrawProgram(const float _distanceField)
+	{
+		if (boundTexture == 0)
 		{
-			GL_CHECK_ERROR(glUseProgram(shaderProgramColorTexture.id));
-			GL_CHECK_ERROR(glUniformMatrix4fv(shaderProgramColorTexture.mvpUniform, 1, GL_FALSE, (float*)&mvpMatrix));
+			useProgram(&shaderProgramColorNoTexture);
+			return;
+		}
 
-			GL_CHECK_ERROR(glVertexAttribPointer(shaderProgramColorTexture.posAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, pos)));
-			GL_CHECK_ERROR(glEnableVertexAttribArray(shaderProgramColorTexture.posAttrib));
+		if (imageEffectEnabled)
+		{
+			useProgram(&shaderProgramImageEffect);
 
-			GL_CHECK_ERROR(glVertexAttribPointer(shaderProgramColorTexture.colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const void*)offsetof(Vertex, col)));
-			GL_CHECK_ERROR(glEnableVertexAttribArray(shaderProgramColorTexture.colAttrib));
+			if (memcmp(imageEffectUniforms, imageEffect, sizeof(imageEffect)) != 0)
+			{
+				GL_CHECK_ERROR(glUniform4f(imageEffectRectUniform, imageEffect[0], imageEffect[1], imageEffect[2], imageEffect[3]));
+				GL_CHECK_ERROR(glUniform1f(imageEffectRadiusUniform, imageEffect[4]));
+				GL_CHECK_ERROR(glUniform1f(imageEffectSaturationUniform, imageEffect[5]));
+				memcpy(imageEffectUniforms, imageEffect, sizeof(imageEffect));
+			}
 
-			GL_CHECK_ERROR(glVertexAttribPointer(shaderProgramColorTexture.texAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, tex)));
-			GL_CHECK_ERROR(glEnableVertexAttribArray(shaderProgramColorTexture.texAttrib));
+			return;
 		}
 
-		if (currentProgram == &shaderProgramColorNoTexture)
+		if (_distanceField <= 0.0f || !shaderProgramDistanceField.linkStatus)
 		{
-			// Setup shader (always NOT textured)
-			GL_CHECK_ERROR(glUseProgram(shaderProgramColorNoTexture.id));
-			GL_CHECK_ERROR(glUniformMatrix4fv(shaderProgramColorNoTexture.mvpUniform, 1, GL_FALSE, (float*)&mvpMatrix));
+			useProgram(&shaderProgramColorTexture);
+			return;
+		}
 
-			GL_CHECK_ERROR(glVertexAttribPointer(shaderProgramColorNoTexture.posAttrib, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const void*)offsetof(Vertex, pos)));
-			GL_CHECK_ERROR(glEnableVertexAttribArray(shaderProgramColorNoTexture.posAttrib));
+		useProgram(&shaderProgramDistanceField);
 
-			GL_CHECK_ERROR(glVertexAttribPointer(shaderProgramColorNoTexture.colAttrib, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (const void*)offsetof(Vertex, col)));
-			GL_CHECK_ERROR(glEnableVertexAttribArray(shaderProgramColorNoTexture.colAttrib));
+		if (distanceFieldUniform != _distanceField)
+		{
+			GL_CHECK_ERROR(glUniform1f(distanceFieldSmoothingUniform, _distanceField));
+			distanceFieldUniform = _distanceField;
 		}
 	}
 
@@ -184,9 +296,132 @@ namespace Renderer
 		GLint texUniform = glGetUniformLocation(shaderProgramColorTexture.id, "u_tex");
 		GL_CHECK_ERROR(glUniform1i(texUniform, 0));
 
+		// fragment shader (distance field texture, same vertex shader)
+		const GLchar* fragmentSourceDistanceField =
+			SHADER_VERSION_STRING
+			"precision highp float;       \n"
+#if defined(USE_OPENGLES_20)
+			"precision mediump sampler2D; \n"
+#endif
+			"varying   vec4      v_col;       \n"
+			"varying   vec2      v_tex;       \n"
+			"uniform   sampler2D u_tex;       \n"
+			"uniform   float     u_smoothing; \n"
+			"void main(void)                                                                  \n"
+			"{                                                                                \n"
+			"    float distance = texture2D(u_tex, v_tex).a;                                  \n"
+			"    float alpha    = smoothstep(0.5 - u_smoothing, 0.5 + u_smoothing, distance); \n"
+			"    gl_FragColor   = vec4(v_col.rgb, v_col.a * alpha);                           \n"
+			"}                                                                                \n";
+
+		const GLuint fragmentShaderDistanceFieldId = glCreateShader(GL_FRAGMENT_SHADER);
+		result = fragmentShaderDistanceField.compile(fragmentShaderDistanceFieldId, fragmentSourceDistanceField);
+		result = shaderProgramDistanceField.linkShaderProgram(vertexShaderTexture, fragmentShaderDistanceField);
+
+		GL_CHECK_ERROR(glUseProgram(shaderProgramDistanceField.id));
+		shaderProgramDistanceField.posAttrib = glGetAttribLocation(shaderProgramDistanceField.id, "a_pos");
+		shaderProgramDistanceField.colAttrib = glGetAttribLocation(shaderProgramDistanceField.id, "a_col");
+		shaderProgramDistanceField.texAttrib = glGetAttribLocation(shaderProgramDistanceField.id, "a_tex");
+		shaderProgramDistanceField.mvpUniform = glGetUniformLocation(shaderProgramDistanceField.id, "u_mvp");
+		distanceFieldSmoothingUniform = glGetUniformLocation(shaderProgramDistanceField.id, "u_smoothing");
+		texUniform = glGetUniformLocation(shaderProgramDistanceField.id, "u_tex");
+		GL_CHECK_ERROR(glUniform1i(texUniform, 0));
+
+		LOG(LogInfo) << " Distance field shader: " << (shaderProgramDistanceField.linkStatus ? "ok" : "failed");
+
+		// vertex shader (image effect) : positions are also passed untransformed, to test them against the mask
+		const GLchar* vertexSourceImageEffect =
+			SHADER_VERSION_STRING
+			"uniform   mat4 u_mvp; \n"
+			"attribute vec2 a_pos; \n"
+			"attribute vec2 a_tex; \n"
+			"attribute vec4 a_col; \n"
+			"varying   vec2 v_pos; \n"
+			"varying   vec2 v_tex; \n"
+			"varying   vec4 v_col; \n"
+			"void main(void)                                     \n"
+			"{                                                   \n"
+			"    gl_Position = u_mvp * vec4(a_pos.xy, 0.0, 1.0); \n"
+			"    v_pos       = a_pos;                            \n"
+			"    v_tex       = a_tex;                            \n"
+			"    v_col       = a_col;                            \n"
+			"}                                                   \n";
+
+		// fragment shader (image effect) : rounded rectangle distance for the mask, luminance mix for the saturation
+		const GLchar* fragmentSourceImageEffect =
+			SHADER_VERSION_STRING
+			"precision highp float;       \n"
+#if defined(USE_OPENGLES_20)
+			"precision mediump sampler2D; \n"
+#endif
+			"varying   vec2      v_pos;        \n"
+			"varying   vec4      v_col;        \n"
+			"varying   vec2      v_tex;        \n"
+			"uniform   sampler2D u_tex;        \n"
+			"uniform   vec4      u_rect;       \n"
+			"uniform   float     u_radius;     \n"
+			"uniform   float     u_saturation; \n"
+			"void main(void)                                                                       \n"
+			"{                                                                                     \n"
+			"    vec4 color = texture2D(u_tex, v_tex) * v_col;                                     \n"
+			"    float gray = dot(color.rgb, vec3(0.299, 0.587, 0.114));                           \n"
+			"    color.rgb  = mix(vec3(gray), color.rgb, u_saturation);                            \n"
+			"    if (u_radius > 0.0)                                                               \n"
+			"    {                                                                                 \n"
+			"        vec2  halfSize = u_rect.zw * 0.5;                                             \n"
+			"        vec2  q        = abs(v_pos - u_rect.xy - halfSize) - halfSize + u_radius;     \n"
+			"        float dist     = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - u_radius;    \n"
+			"        color.a       *= clamp(0.5 - dist, 0.0, 1.0);                                 \n"
+			"    }                                                                                 \n"
+			"    gl_FragColor = color;                                                             \n"
+			"}                                                                                     \n";
+
+		const GLuint vertexShaderImageEffectId = glCreateShader(GL_VERTEX_SHADER);
+		result = vertexShaderImageEffect.compile(vertexShaderImageEffectId, vertexSourceImageEffect);
+		const GLuint fragmentShaderImageEffectId = glCreateShader(GL_FRAGMENT_SHADER);
+		result = fragmentShaderImageEffect.compile(fragmentShaderImageEffectId, fragmentSourceImageEffect);
+		result = shaderProgramImageEffect.linkShaderProgram(vertexShaderImageEffect, fragmentShaderImageEffect);
+
+		GL_CHECK_ERROR(glUseProgram(shaderProgramImageEffect.id));
+		shaderProgramImageEffect.posAttrib = glGetAttribLocation(shaderProgramImageEffect.id, "a_pos");
+		shaderProgramImageEffect.colAttrib = glGetAttribLocation(shaderProgramImageEffect.id, "a_col");
+		shaderProgramImageEffect.texAttrib = glGetAttribLocation(shaderProgramImageEffect.id, "a_tex");
+		shaderProgramImageEffect.mvpUniform = glGetUniformLocation(shaderProgramImageEffect.id, "u_mvp");
+		imageEffectRectUniform = glGetUniformLocation(shaderProgramImageEffect.id, "u_rect");
+		imageEffectRadiusUniform = glGetUniformLocation(shaderProgramImageEffect.id, "u_radius");
+		imageEffectSaturationUniform = glGetUniformLocation(shaderProgramImageEffect.id, "u_saturation");
+		texUniform = glGetUniformLocation(shaderProgramImageEffect.id, "u_tex");
+		GL_CHECK_ERROR(glUniform1i(texUniform, 0));
+
+		LOG(LogInfo) << " Image effect shader: " << (shaderProgramImageEffect.linkStatus ? "ok" : "failed");
+
 		useProgram(nullptr);
 	} // setupShaders
 
+//////////////////////////////////////////////////////////////////////////
+
+	// A new context starts with the default GL state
+	static void resetStateCache()
+	{
+		currentProgram = nullptr;
+		boundTexture   = 0;
+		blendEnabled   = false;
+		blendSrcFactor = GL_ONE;
+		blendDstFactor = GL_ZERO;
+		scissorEnabled = false;
+		scissorRect    = Rect(0, 0, 0, 0);
+		blendSeparate  = false;
+
+		memset(&textureProgramMatrix, 0, sizeof(Transform4x4f));
+		memset(&noTextureProgramMatrix, 0, sizeof(Transform4x4f));
+		memset(&distanceFieldMatrix, 0, sizeof(Transform4x4f));
+		distanceFieldUniform = -1.0f;
+		memset(&imageEffectMatrix, 0, sizeof(Transform4x4f));
+		memset(imageEffectUniforms, 0, sizeof(imageEffectUniforms));
+		imageEffectEnabled = false;
+
+	} // resetStateCache
+
 //////////////////////////////////////////////////////////////////////////
 
 	static void setupVertexBuffer()
@@ -194,8 +429,51 @@ namespace Renderer
 		GL_CHECK_ERROR(glGenBuffers(1, &vertexBuffer));
 		GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer));
 
+		GL_CHECK_ERROR(glGenBuffers(1, &indexBuffer));
+		GL_CHECK_ERROR(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer));
+
+		batchingEnabled = Settings::getInstance()->getBool("BatchRendering");
+		batchVertices.reserve(BATCH_MAX_VERTICES);
+		batchIndices.reserve(BATCH_MAX_VERTICES * 3);
+
+		LOG(LogInfo) << " Draw batching: " << (batchingEnabled ? "enabled" : "disabled");
+
 	} // setupVertexBuffer
 
+//////////////////////////////////////////////////////////////////////////
+
+	static void setupRenderTargets()
+	{
+		renderTargets.clear();
+		currentRenderTarget = 0;
+
+#if OPENGL_EXTENSIONS
+		bool supported = glGenFramebuffers != nullptr && glBlendFuncSeparate != nullptr;
+#else
+		bool supported = true; // Framebuffer objects are core in GLES 2
+#endif
+
+		renderTargetsSupported = supported && Settings::getInstance()->getBool("BitmapCaching");
+		LOG(LogInfo) << " Render targets: " << (renderTargetsSupported ? "ok" : "disabled");
+
+	} // setupRenderTargets
+
+//////////////////////////////////////////////////////////////////////////
+
+	// Height of the buffer draws currently go to : GL coordinates start at its bottom left
+	static int getFramebufferHeight()
+	{
+		if (currentRenderTarget != 0)
+		{
+			auto it = renderTargets.find(currentRenderTarget);
+			if (it != renderTargets.cend())
+				return it->second.height;
+		}
+
+		return getWindowHeight();
+
+	} // getFramebufferHeight
+
 //////////////////////////////////////////////////////////////////////////
 
 	static GLenum convertBlendFactor(const Blend::Factor _blendFactor)
@@ -217,6 +495,36 @@ namespace Renderer
 
 	} // convertBlendFactor
 
+//////////////////////////////////////////////////////////////////////////
+
+	// Every draw is blended : GL_BLEND stays enabled and only real blend function changes reach the driver
+	static void setBlendFunc(const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if (!blendEnabled)
+		{
+			GL_CHECK_ERROR(glEnable(GL_BLEND));
+			blendEnabled = true;
+		}
+
+		const GLenum src = convertBlendFactor(_srcBlendFactor);
+		const GLenum dst = convertBlendFactor(_dstBlendFactor);
+		const bool separate = (currentRenderTarget != 0);
+		if (src == blendSrcFactor && dst == blendDstFactor && separate == blendSeparate)
+			return;
+
+		if (separate)
+			GL_CHECK_ERROR(glBlendFuncSeparate(src, dst, GL_ONE, GL_ONE_MINUS_SRC_ALPHA));
+		else
+			GL_CHECK_ERROR(glBlendFunc(src, dst));
+
+		blendSrcFactor = src;
+		blendDstFactor = dst;
+		blendSeparate = separate;
+
+		getCurrentFrameStats().blendChanges++;
+
+	} // setBlendFunc
+
 //////////////////////////////////////////////////////////////////////////
 
 	static GLenum convertTextureType(const Texture::Type _type)
@@ -230,6 +538,32 @@ namespace Renderer
 
 	} // convertTextureType
 
+//////////////////////////////////////////////////////////////////////////
+
+	// Draws the pending batch. Has to be called before any GL state change the batched triangles depend on
+	static void flushBatch()
+	{
+		if (batchIndices.empty())
+			return;
+
+		useDrawProgram(batchDistanceField);
+
+		// Batched vertices are already in world space
+		setMvpUniform(currentProgram, projectionMatrix);
+
+		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * batchVertices.size(), batchVertices.data(), GL_STREAM_DRAW));
+		GL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * batchIndices.size(), batchIndices.data(), GL_STREAM_DRAW));
+
+		setBlendFunc(batchSrcBlendFactor, batchDstBlendFactor);
+		GL_CHECK_ERROR(glDrawElements(GL_TRIANGLES, batchIndices.size(), GL_UNSIGNED_SHORT, 0));
+
+		getCurrentFrameStats().drawCalls++;
+
+		batchVertices.clear();
+		batchIndices.clear();
+
+	} // flushBatch
+
 //////////////////////////////////////////////////////////////////////////
 
 	unsigned int convertColor(const unsigned int _color)
@@ -331,8 +665,10 @@ namespace Renderer
 		initializeGlExtensions();
 #endif
 
+		resetStateCache();
 		setupShaders();
 		setupVertexBuffer();
+		setupRenderTargets();
 
 		GL_CHECK_ERROR(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
 
@@ -385,6 +721,11 @@ namespace Renderer
 
 	void destroyContext()
 	{
+		flushBatch();
+		staticVertexBuffers.clear();
+		renderTargets.clear();
+		currentRenderTarget = 0;
+
 		SDL_GL_DeleteContext(sdlContext);
 		sdlContext = nullptr;
 
@@ -445,6 +786,7 @@ namespace Renderer
 		else
 		{
 			glTexImage2D(GL_TEXTURE_2D, 0, type, _width, _height, 0, type, GL_UNSIGNED_BYTE, _data);
+
 			if (glGetError() != GL_NO_ERROR)
 			{
 				LOG(LogError) << "CreateTexture error: glTexImage2D failed";
@@ -453,6 +795,9 @@ namespace Renderer
 			}
 		}
 
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
 		return texture;
 
 	} // createTexture
@@ -461,6 +806,12 @@ namespace Renderer
 
 	void destroyTexture(const unsigned int _texture)
 	{
+		flushBatch();
+
+		// Deleting the bound texture reverts the binding to 0
+		if (boundTexture == _texture)
+			boundTexture = 0;
+
 		GL_CHECK_ERROR(glDeleteTextures(1, &_texture));
 
 	} // destroyTexture
@@ -471,6 +822,8 @@ namespace Renderer
 	{
 		const GLenum type = convertTextureType(_type);
 
+		// Pending draws must use the texture as it was
+		flushBatch();
 		bindTexture(_texture);
 
 		// Regular GL_ALPHA textures are black + alpha in shaders
@@ -494,17 +847,20 @@ namespace Renderer
 
 		bindTexture(0);
 
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
 	} // updateTexture
 
 //////////////////////////////////////////////////////////////////////////
 
-	static unsigned int boundTexture = 0;
-
 	void bindTexture(const unsigned int _texture)
 	{
 		if (boundTexture == _texture)
 			return;
 
+		flushBatch();
+
 		boundTexture = _texture;
 
 		if(_texture == 0)
@@ -518,51 +874,342 @@ namespace Renderer
 			boundTexture = _texture;
 		}
 
+		getCurrentFrameStats().textureBinds++;
+
 	} // bindTexture
 
 //////////////////////////////////////////////////////////////////////////
 
 	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
+		flushBatch();
+
 		// Pass buffer data
 		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));
 
 		useProgram(&shaderProgramColorNoTexture);
 
 		// Do rendering
-		GL_CHECK_ERROR(glEnable(GL_BLEND));
-		GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
 		GL_CHECK_ERROR(glDrawArrays(GL_LINES, 0, _numVertices));
-		GL_CHECK_ERROR(glDisable(GL_BLEND));
+
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
 
 	} // drawLines
 
 //////////////////////////////////////////////////////////////////////////
 
 
+	static void addToBatch(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		const float distanceField = getDistanceFieldSmoothing();
+
+		if (batchSrcBlendFactor != _srcBlendFactor || batchDstBlendFactor != _dstBlendFactor || batchDistanceField != distanceField || batchVertices.size() + _numVertices > BATCH_MAX_VERTICES)
+			flushBatch();
+
+		batchSrcBlendFactor = _srcBlendFactor;
+		batchDstBlendFactor = _dstBlendFactor;
+		batchDistanceField  = distanceField;
+
+		const float*   tm   = (float*)&worldViewMatrix;
+		const GLushort base = (GLushort)batchVertices.size();
+
+		for (unsigned int i = 0; i < _numVertices; ++i)
+		{
+			const Vector2f& pos = _vertices[i].pos;
+
+			batchVertices.push_back(_vertices[i]);
+			batchVertices.back().pos = Vector2f(tm[0] * pos.x() + tm[4] * pos.y() + tm[12], tm[1] * pos.x() + tm[5] * pos.y() + tm[13]);
+		}
+
+		// Strip to triangle list. Every other triangle is flipped to keep the winding, degenerate ones are dropped
+		for (unsigned int i = 0; i + 2 < _numVertices; ++i)
+		{
+			const unsigned int a = (i & 1) ? i + 1 : i;
+			const unsigned int b = (i & 1) ? i : i + 1;
+			const unsigned int c = i + 2;
+
+			if (_vertices[a].pos == _vertices[b].pos || _vertices[b].pos == _vertices[c].pos || _vertices[a].pos == _vertices[c].pos)
+				continue;
+
+			batchIndices.push_back(base + a);
+			batchIndices.push_back(base + b);
+			batchIndices.push_back(base + c);
+		}
+
+	} // addToBatch
+
+//////////////////////////////////////////////////////////////////////////
+
 	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
 	{
+		getCurrentFrameStats().draws++;
+
+		// Image effects depend on untransformed positions : these draws are never batched
+		if (batchingEnabled && !imageEffectEnabled && _numVertices <= BATCH_MAX_VERTICES)
+		{
+			addToBatch(_vertices, _numVertices, _srcBlendFactor, _dstBlendFactor);
+			return;
+		}
+
+		flushBatch();
+
 		// Pass buffer data
 		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));		
 
 		// Setup shader
-		if (boundTexture != 0)
-			useProgram(&shaderProgramColorTexture);
-		else
-			useProgram(&shaderProgramColorNoTexture);
+		useDrawProgram(getDistanceFieldSmoothing());
 
 		// Do rendering
-		GL_CHECK_ERROR(glEnable(GL_BLEND));
-		GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
 		GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices));
-		GL_CHECK_ERROR(glDisable(GL_BLEND));
+
+		getCurrentFrameStats().drawCalls++;
 
 	} // drawTriangleStrips
 
+//////////////////////////////////////////////////////////////////////////
+
+	unsigned int createStaticVertexBuffer(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		if (_numVertices == 0)
+			return 0;
+
+		GLuint buffer = 0;
+
+		glGetError();
+		glGenBuffers(1, &buffer);
+		glBindBuffer(GL_ARRAY_BUFFER, buffer);
+		glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_STATIC_DRAW);
+		glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+
+		if (glGetError() != GL_NO_ERROR)
+		{
+			glDeleteBuffers(1, &buffer);
+			return 0;
+		}
+
+		const unsigned int handle = nextStaticVertexBuffer++;
+		staticVertexBuffers[handle] = buffer;
+		return handle;
+
+	} // createStaticVertexBuffer
+
+//////////////////////////////////////////////////////////////////////////
+
+	void destroyStaticVertexBuffer(const unsigned int _buffer)
+	{
+		auto it = staticVertexBuffers.find(_buffer);
+		if (it == staticVertexBuffers.cend())
+			return;
+
+		GL_CHECK_ERROR(glDeleteBuffers(1, &it->second));
+		staticVertexBuffers.erase(it);
+
+	} // destroyStaticVertexBuffer
+
+//////////////////////////////////////////////////////////////////////////
+
+	bool drawStaticVertexBuffer(const unsigned int _buffer, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		auto it = staticVertexBuffers.find(_buffer);
+		if (it == staticVertexBuffers.cend())
+			return false;
+
+		flushBatch();
+		useDrawProgram(getDistanceFieldSmoothing());
+
+		GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, it->second));
+		setVertexAttribPointers(currentProgram);
+
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
+		GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_STRIP, 0, _numVertices));
+
+		GL_CHECK_ERROR(glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer));
+		setVertexAttribPointers(currentProgram);
+
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
+
+		return true;
+
+	} // drawStaticVertexBuffer
+
+//////////////////////////////////////////////////////////////////////////
+
+	bool isRenderTargetSupported()
+	{
+		return renderTargetsSupported;
+
+	} // isRenderTargetSupported
+
+//////////////////////////////////////////////////////////////////////////
+
+	unsigned int createRenderTarget(const unsigned int _width, const unsigned int _height)
+	{
+		if (!renderTargetsSupported || _width == 0 || _height == 0)
+			return 0;
+
+		flushBatch();
+
+		const unsigned int texture = createTexture(Texture::RGBA, true, false, _width, _height, nullptr);
+		if (texture == 0)
+			return 0;
+
+		GLuint framebuffer = 0;
+
+		glGetError();
+		glGenFramebuffers(1, &framebuffer);
+		glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+		const bool complete = (glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE) && glGetError() == GL_NO_ERROR;
+
+		auto current = renderTargets.find(currentRenderTarget);
+		glBindFramebuffer(GL_FRAMEBUFFER, current == renderTargets.cend() ? 0 : current->second.framebuffer);
+
+		if (!complete)
+		{
+			LOG(LogWarning) << "createRenderTarget error: framebuffer incomplete (" << _width << "x" << _height << ")";
+			glDeleteFramebuffers(1, &framebuffer);
+			destroyTexture(texture);
+			return 0;
+		}
+
+		RenderTarget target;
+		target.framebuffer = framebuffer;
+		target.texture = texture;
+		target.width = _width;
+		target.height = _height;
+
+		const unsigned int handle = nextRenderTarget++;
+		renderTargets[handle] = target;
+		return handle;
+
+	} // createRenderTarget
+
+//////////////////////////////////////////////////////////////////////////
+
+	void destroyRenderTarget(const unsigned int _target)
+	{
+		auto it = renderTargets.find(_target);
+		if (it == renderTargets.cend())
+			return;
+
+		if (currentRenderTarget == _target)
+			bindRenderTarget(0, false);
+
+		GL_CHECK_ERROR(glDeleteFramebuffers(1, &it->second.framebuffer));
+		destroyTexture(it->second.texture);
+		renderTargets.erase(it);
+
+	} // destroyRenderTarget
+
+//////////////////////////////////////////////////////////////////////////
+
+	unsigned int getRenderTargetTexture(const unsigned int _target)
+	{
+		auto it = renderTargets.find(_target);
+		return it == renderTargets.cend() ? 0 : it->second.texture;
+
+	} // getRenderTargetTexture
+
+//////////////////////////////////////////////////////////////////////////
+
+	bool bindRenderTarget(const unsigned int _target, const bool _clear)
+	{
+		GLuint framebuffer = 0;
+
+		if (_target != 0)
+		{
+			auto it = renderTargets.find(_target);
+			if (it == renderTargets.cend())
+				return false;
+
+			framebuffer = it->second.framebuffer;
+		}
+
+		flushBatch();
+
+		if (_target != currentRenderTarget)
+		{
+			GL_CHECK_ERROR(glBindFramebuffer(GL_FRAMEBUFFER, framebuffer));
+			currentRenderTarget = _target;
+		}
+
+		if (_clear)
+		{
+			// The whole target is cleared to transparent, whatever the current clipping
+			setScissor(Rect(0, 0, 0, 0));
+
+			GL_CHECK_ERROR(glClearColor(0.0f, 0.0f, 0.0f, 0.0f));
+			GL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT));
+			GL_CHECK_ERROR(glClearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		}
+
+		return true;
+
+	} // bindRenderTarget
+
+//////////////////////////////////////////////////////////////////////////
+
+	bool isDistanceFieldSupported()
+	{
+		return shaderProgramDistanceField.linkStatus;
+
+	} // isDistanceFieldSupported
+
+//////////////////////////////////////////////////////////////////////////
+
+	void setDistanceField(const float _smoothing)
+	{
+		// Batched vertices are flushed with the smoothing they were added with
+		distanceFieldSmoothing = _smoothing;
+
+	} // setDistanceField
+
+//////////////////////////////////////////////////////////////////////////
+
+	bool isImageEffectSupported()
+	{
+		return shaderProgramImageEffect.linkStatus;
+
+	} // isImageEffectSupported
+
+//////////////////////////////////////////////////////////////////////////
+
+	void setImageEffect(const float _x, const float _y, const float _width, const float _height, const float _radius, const float _saturation)
+	{
+		if (!shaderProgramImageEffect.linkStatus)
+			return;
+
+		flushBatch();
+
+		imageEffect[0] = _x;
+		imageEffect[1] = _y;
+		imageEffect[2] = _width;
+		imageEffect[3] = _height;
+		imageEffect[4] = Math::min(_radius, Math::min(_width, _height) / 2.0f);
+		imageEffect[5] = _saturation;
+		imageEffectEnabled = true;
+
+	} // setImageEffect
+
+//////////////////////////////////////////////////////////////////////////
+
+	void resetImageEffect()
+	{
+		imageEffectEnabled = false;
+
+	} // resetImageEffect
+
 //////////////////////////////////////////////////////////////////////////
 
 	void setProjection(const Transform4x4f& _projection)
 	{
+		flushBatch();
+
 		projectionMatrix = _projection;
 		mvpMatrix = projectionMatrix * worldViewMatrix;
 	} // setProjection
@@ -580,8 +1227,10 @@ namespace Renderer
 
 	void setViewport(const Rect& _viewport)
 	{
+		flushBatch();
+
 		// glViewport starts at the bottom left of the window
-		GL_CHECK_ERROR(glViewport( _viewport.x, getWindowHeight() - _viewport.y - _viewport.h, _viewport.w, _viewport.h));
+		GL_CHECK_ERROR(glViewport( _viewport.x, getFramebufferHeight() - _viewport.y - _viewport.h, _viewport.w, _viewport.h));
 
 	} // setViewport
 
@@ -591,13 +1240,29 @@ namespace Renderer
 	{
 		if((_scissor.x == 0) && (_scissor.y == 0) && (_scissor.w == 0) && (_scissor.h == 0))
 		{
+			if (!scissorEnabled)
+				return;
+
+			flushBatch();
 			GL_CHECK_ERROR(glDisable(GL_SCISSOR_TEST));
+			scissorEnabled = false;
 		}
 		else
 		{
+			if (scissorEnabled && _scissor.x == scissorRect.x && _scissor.y == scissorRect.y && _scissor.w == scissorRect.w && _scissor.h == scissorRect.h)
+				return;
+
+			flushBatch();
+
 			// glScissor starts at the bottom left of the window
-			GL_CHECK_ERROR(glScissor(_scissor.x, getWindowHeight() - _scissor.y - _scissor.h, _scissor.w, _scissor.h));
-			GL_CHECK_ERROR(glEnable(GL_SCISSOR_TEST));
+			GL_CHECK_ERROR(glScissor(_scissor.x, getFramebufferHeight() - _scissor.y - _scissor.h, _scissor.w, _scissor.h));
+			scissorRect = _scissor;
+
+			if (!scissorEnabled)
+			{
+				GL_CHECK_ERROR(glEnable(GL_SCISSOR_TEST));
+				scissorEnabled = true;
+			}
 		}
 
 	} // setScissor
@@ -627,33 +1292,37 @@ namespace Renderer
 
 	void swapBuffers()
 	{
+		flushBatch();
 		useProgram(nullptr);
 		SDL_GL_SwapWindow(getSDLWindow());
 		GL_CHECK_ERROR(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+		resetTextureUploadBudget();
+		resetFrameStats();
 	} // swapBuffers
 
 //////////////////////////////////////////////////////////////////////////
 	
 	void drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
-	{		
+	{
+		flushBatch();
+
 		// Pass buffer data
 		GL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * _numVertices, _vertices, GL_DYNAMIC_DRAW));
 
 		// Setup shader
-		if (boundTexture != 0)
-			useProgram(&shaderProgramColorTexture);
-		else
-			useProgram(&shaderProgramColorNoTexture);
+		useDrawProgram(getDistanceFieldSmoothing());
 
 		// Do rendering
-		GL_CHECK_ERROR(glEnable(GL_BLEND));
-		GL_CHECK_ERROR(glBlendFunc(convertBlendFactor(_srcBlendFactor), convertBlendFactor(_dstBlendFactor)));
+		setBlendFunc(_srcBlendFactor, _dstBlendFactor);
 		GL_CHECK_ERROR(glDrawArrays(GL_TRIANGLE_FAN, 0, _numVertices));
-		GL_CHECK_ERROR(glDisable(GL_BLEND));
+
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
 	}
 
 	void setStencil(const Vertex* _vertices, const unsigned int _numVertices)
 	{
+		flushBatch();
 		useProgram(&shaderProgramColorNoTexture);
 
 		glEnable(GL_STENCIL_TEST);
@@ -676,6 +1345,7 @@ namespace Renderer
 
 	void disableStencil()
 	{
+		flushBatch();
 		glDisable(GL_STENCIL_TEST);
 	}
 } // Renderer::
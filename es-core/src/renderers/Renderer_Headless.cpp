@@ -0,0 +1,335 @@
+#if defined(USE_HEADLESS_RENDERER)
+
+#include "renderers/Renderer.h"
+#include "math/Transform4x4f.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <SDL.h>
+#include <map>
+#include <vector>
+
+// Renderer without GPU : draws are only counted, textures only keep their size.
+// Used to run frame benchmarks on machines without a display (SDL dummy video driver)
+namespace Renderer
+{
+	struct HeadlessTexture
+	{
+		Texture::Type type;
+		unsigned int  width;
+		unsigned int  height;
+	};
+
+	static std::map<unsigned int, HeadlessTexture> textures;
+	static unsigned int                            nextTexture  = 1;
+	static unsigned int                            boundTexture = 0;
+
+	// Render target handle -> texture
+	static std::map<unsigned int, unsigned int>    renderTargets;
+	static unsigned int                            nextRenderTarget = 1;
+
+	// Batch state, following the GLES20 batching rules so drawCalls can be compared between backends
+	static bool                                    batchingEnabled     = false;
+	static unsigned int                            batchVertexCount    = 0;
+	static Blend::Factor                           batchSrcBlendFactor = Blend::SRC_ALPHA;
+	static Blend::Factor                           batchDstBlendFactor = Blend::ONE_MINUS_SRC_ALPHA;
+	static bool                                    scissorEnabled      = false;
+	static Rect                                    scissorRect         = Rect(0, 0, 0, 0);
+
+	#define BATCH_MAX_VERTICES	8192
+
+	unsigned int convertColor(const unsigned int _color)
+	{
+		// convert from rgba to abgr
+		unsigned char r = ((_color & 0xff000000) >> 24) & 255;
+		unsigned char g = ((_color & 0x00ff0000) >> 16) & 255;
+		unsigned char b = ((_color & 0x0000ff00) >>  8) & 255;
+		unsigned char a = ((_color & 0x000000ff)      ) & 255;
+
+		return ((a << 24) | (b << 16) | (g << 8) | (r));
+
+	} // convertColor
+
+	unsigned int getWindowFlags()
+	{
+		return SDL_WINDOW_HIDDEN;
+
+	} // getWindowFlags
+
+	void setupWindow()
+	{
+	} // setupWindow
+
+	std::vector<std::pair<std::string, std::string>> getDriverInformation()
+	{
+		std::vector<std::pair<std::string, std::string>> info;
+		info.push_back(std::pair<std::string, std::string>("GRAPHICS API", "HEADLESS"));
+		return info;
+
+	} // getDriverInformation
+
+	void createContext()
+	{
+		boundTexture = 0;
+		batchVertexCount = 0;
+		scissorEnabled = false;
+		batchingEnabled = Settings::getInstance()->getBool("BatchRendering");
+
+	} // createContext
+
+	void destroyContext()
+	{
+		// Like a GL context, textures don't survive the renderer
+		textures.clear();
+		renderTargets.clear();
+
+	} // destroyContext
+
+	unsigned int createTexture(const Texture::Type _type, const bool _linear, const bool _repeat, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		HeadlessTexture texture;
+		texture.type = _type;
+		texture.width = _width;
+		texture.height = _height;
+
+		textures[nextTexture] = texture;
+
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
+		return nextTexture++;
+
+	} // createTexture
+
+	// A pending batch counts as one draw call when a state change would make GL draw it
+	static void flushBatch()
+	{
+		if (batchVertexCount == 0)
+			return;
+
+		getCurrentFrameStats().drawCalls++;
+		batchVertexCount = 0;
+
+	} // flushBatch
+
+	void destroyTexture(const unsigned int _texture)
+	{
+		flushBatch();
+
+		if (boundTexture == _texture)
+			boundTexture = 0;
+
+		textures.erase(_texture);
+
+	} // destroyTexture
+
+	void updateTexture(const unsigned int _texture, const Texture::Type _type, const unsigned int _x, const unsigned _y, const unsigned int _width, const unsigned int _height, void* _data)
+	{
+		auto it = textures.find(_texture);
+		if (it == textures.cend())
+		{
+			LOG(LogError) << "updateTexture error: unknown texture " << _texture;
+			return;
+		}
+
+		flushBatch();
+
+		// (unsigned int)-1 for both : the texture is reallocated at the new size
+		if (_x == (unsigned int)-1 && _y == (unsigned int)-1)
+		{
+			it->second.width = _width;
+			it->second.height = _height;
+		}
+
+		if (_data != nullptr)
+			addTextureUploadStats(_type, _width, _height);
+
+	} // updateTexture
+
+	void bindTexture(const unsigned int _texture)
+	{
+		if (boundTexture == _texture)
+			return;
+
+		flushBatch();
+
+		boundTexture = _texture;
+		getCurrentFrameStats().textureBinds++;
+
+	} // bindTexture
+
+	// Draw that is never batched
+	static void countDraw()
+	{
+		flushBatch();
+
+		getCurrentFrameStats().draws++;
+		getCurrentFrameStats().drawCalls++;
+
+	} // countDraw
+
+	void drawLines(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		countDraw();
+
+	} // drawLines
+
+	void drawTriangleStrips(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		if (!batchingEnabled || _numVertices > BATCH_MAX_VERTICES)
+		{
+			countDraw();
+			return;
+		}
+
+		getCurrentFrameStats().draws++;
+
+		// Vertices are batched already transformed : only blend changes and a full batch break it, not the matrix
+		if (batchSrcBlendFactor != _srcBlendFactor || batchDstBlendFactor != _dstBlendFactor || batchVertexCount + _numVertices > BATCH_MAX_VERTICES)
+			flushBatch();
+
+		batchSrcBlendFactor = _srcBlendFactor;
+		batchDstBlendFactor = _dstBlendFactor;
+		batchVertexCount += _numVertices;
+
+	} // drawTriangleStrips
+
+	void drawTriangleFan(const Vertex* _vertices, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		countDraw();
+
+	} // drawTriangleFan
+
+	bool isDistanceFieldSupported()
+	{
+		return false;
+
+	} // isDistanceFieldSupported
+
+	void setDistanceField(const float _smoothing)
+	{
+	} // setDistanceField
+
+	bool isImageEffectSupported()
+	{
+		return false;
+
+	} // isImageEffectSupported
+
+	void setImageEffect(const float _x, const float _y, const float _width, const float _height, const float _radius, const float _saturation)
+	{
+	} // setImageEffect
+
+	void resetImageEffect()
+	{
+	} // resetImageEffect
+
+	unsigned int createStaticVertexBuffer(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		return 0;
+
+	} // createStaticVertexBuffer
+
+	void destroyStaticVertexBuffer(const unsigned int _buffer)
+	{
+	} // destroyStaticVertexBuffer
+
+	bool drawStaticVertexBuffer(const unsigned int _buffer, const unsigned int _numVertices, const Blend::Factor _srcBlendFactor, const Blend::Factor _dstBlendFactor)
+	{
+		return false;
+
+	} // drawStaticVertexBuffer
+
+	bool isRenderTargetSupported()
+	{
+		return Settings::getInstance()->getBool("BitmapCaching");
+
+	} // isRenderTargetSupported
+
+	unsigned int createRenderTarget(const unsigned int _width, const unsigned int _height)
+	{
+		flushBatch();
+		renderTargets[nextRenderTarget] = createTexture(Texture::RGBA, true, false, _width, _height, nullptr);
+		return nextRenderTarget++;
+
+	} // createRenderTarget
+
+	void destroyRenderTarget(const unsigned int _target)
+	{
+		auto it = renderTargets.find(_target);
+		if (it == renderTargets.cend())
+			return;
+
+		destroyTexture(it->second);
+		renderTargets.erase(it);
+
+	} // destroyRenderTarget
+
+	unsigned int getRenderTargetTexture(const unsigned int _target)
+	{
+		auto it = renderTargets.find(_target);
+		return it == renderTargets.cend() ? 0 : it->second;
+
+	} // getRenderTargetTexture
+
+	bool bindRenderTarget(const unsigned int _target, const bool _clear)
+	{
+		flushBatch();
+		return _target == 0 || renderTargets.find(_target) != renderTargets.cend();
+
+	} // bindRenderTarget
+
+	void setProjection(const Transform4x4f& _projection)
+	{
+		flushBatch();
+	} // setProjection
+
+	void setMatrix(const Transform4x4f& _matrix)
+	{
+	} // setMatrix
+
+	void setViewport(const Rect& _viewport)
+	{
+		flushBatch();
+	} // setViewport
+
+	void setScissor(const Rect& _scissor)
+	{
+		const bool enable = _scissor.x != 0 || _scissor.y != 0 || _scissor.w != 0 || _scissor.h != 0;
+
+		// Like GLES20, an unchanged scissor doesn't break the batch
+		if (enable == scissorEnabled && (!enable || (_scissor.x == scissorRect.x && _scissor.y == scissorRect.y && _scissor.w == scissorRect.w && _scissor.h == scissorRect.h)))
+			return;
+
+		flushBatch();
+
+		scissorEnabled = enable;
+		scissorRect = _scissor;
+	} // setScissor
+
+	void setSwapInterval()
+	{
+	} // setSwapInterval
+
+	void swapBuffers()
+	{
+		flushBatch();
+		resetTextureUploadBudget();
+		resetFrameStats();
+
+	} // swapBuffers
+
+	void setStencil(const Vertex* _vertices, const unsigned int _numVertices)
+	{
+		countDraw();
+
+	} // setStencil
+
+	void disableStencil()
+	{
+		flushBatch();
+	} // disableStencil
+
+} // Renderer::
+
+#endif // USE_HEADLESS_RENDERER
@@ -1,3 +1,5 @@
+#if !defined(USE_HEADLESS_RENDERER)
+
 #include "Shader.h"
 #include "Log.h"
 
@@ -98,4 +100,6 @@ namespace Renderer
 		return false;
 	}
 
-}
\ No newline at end of file
+}
+
+#endif // !USE_HEADLESS_RENDERER
@@ -12,11 +12,704 @@
 #include "Settings.h"
 #include "ImageIO.h"
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #ifdef WIN32
 #include <Windows.h>
 #endif
 
+// Text caches with at least this number of vertices (64 glyphs) are drawn from a static vertex buffer
+#define STATIC_TEXT_MIN_VERTICES (6 * 64)
+
+// Wrapped texts kept by each font, so that laying out the same descriptions again is free
+#define TEXT_LAYOUT_CACHE_SIZE 64
+
+// Distance field glyphs are computed for this font size, from a bitmap rasterized DISTANCE_FIELD_OVERSAMPLING times larger
+#define DISTANCE_FIELD_SIZE			48
+#define DISTANCE_FIELD_SPREAD		6 // distance stored around the glyphs, in pixels at DISTANCE_FIELD_SIZE
+#define DISTANCE_FIELD_OVERSAMPLING	2
+
+// Glyphs rasterized ahead of time wait in memory until their font uses them, up to this size for each font :
+// fonts that are never drawn don't take the room of the others
+#define PREWARM_FONT_MAX_BYTES (1024 * 1024)
+#define PREWARM_BATCH_SIZE 32
+
+#define GLYPHCACHE_MAGIC "ESGC"
+#define GLYPHCACHE_VERSION 1
+
+//=============================================================================================================
+//DistanceFieldAtlas
+//=============================================================================================================
+
+class Font::DistanceFieldAtlas
+{
+public:
+	static std::shared_ptr<DistanceFieldAtlas> get(const std::string& path);
+	static size_t getTotalMemUsage();
+
+	DistanceFieldAtlas(const std::string& path);
+	~DistanceFieldAtlas();
+
+	// Returns the glyph at DISTANCE_FIELD_SIZE
+	Glyph* getGlyph(unsigned int id);
+
+	void clearFaceCache() { mFaceCache.clear(); }
+
+	// Textures are released when no loaded font uses them anymore
+	void acquire();
+	void release();
+
+private:
+	// Pixels are kept to restore the pages after a renderer reinit without computing the distances again
+	struct Page
+	{
+		FontTexture* texture;
+		std::vector<unsigned char> pixels;
+	};
+
+	Page* getPageForNewGlyph(const Vector2i& size, Vector2i& cursor_out);
+
+	std::string mPath;
+	std::vector<Page*> mPages;
+	std::map<unsigned int, Glyph*> mGlyphMap;
+	std::map< unsigned int, std::unique_ptr<FontFace> > mFaceCache;
+	int mLoadedFonts;
+
+	static std::map<std::string, std::weak_ptr<DistanceFieldAtlas>> sAtlasMap;
+};
+
+std::map<std::string, std::weak_ptr<Font::DistanceFieldAtlas>> Font::DistanceFieldAtlas::sAtlasMap;
+
+std::shared_ptr<Font::DistanceFieldAtlas> Font::DistanceFieldAtlas::get(const std::string& path)
+{
+	auto it = sAtlasMap.find(path);
+	if (it != sAtlasMap.cend() && !it->second.expired())
+		return it->second.lock();
+
+	auto atlas = std::make_shared<DistanceFieldAtlas>(path);
+	sAtlasMap[path] = atlas;
+	return atlas;
+}
+
+size_t Font::DistanceFieldAtlas::getTotalMemUsage()
+{
+	size_t total = 0;
+
+	for (auto it = sAtlasMap.cbegin(); it != sAtlasMap.cend(); it++)
+	{
+		auto atlas = it->second.lock();
+		if (atlas == nullptr)
+			continue;
+
+		for (auto page : atlas->mPages)
+			total += (page->texture->textureId != 0 ? page->texture->textureSize.x() * page->texture->textureSize.y() * 4 : 0);
+	}
+
+	return total;
+}
+
+Font::DistanceFieldAtlas::DistanceFieldAtlas(const std::string& path) : mPath(path), mLoadedFonts(0)
+{
+}
+
+Font::DistanceFieldAtlas::~DistanceFieldAtlas()
+{
+	for (auto glyph : mGlyphMap)
+		delete glyph.second;
+
+	for (auto page : mPages)
+	{
+		delete page->texture;
+		delete page;
+	}
+}
+
+void Font::DistanceFieldAtlas::release()
+{
+	if (mLoadedFonts <= 0 || --mLoadedFonts > 0)
+		return;
+
+	for (auto page : mPages)
+		page->texture->deinitTexture();
+}
+
+void Font::DistanceFieldAtlas::acquire()
+{
+	if (mLoadedFonts++ > 0)
+		return;
+
+	for (auto page : mPages)
+	{
+		if (page->texture->textureId != 0)
+			continue;
+
+		page->texture->initTexture();
+		Renderer::updateTexture(page->texture->textureId, Renderer::Texture::ALPHA, 0, 0, page->texture->textureSize.x(), page->texture->textureSize.y(), page->pixels.data());
+	}
+}
+
+Font::DistanceFieldAtlas::Page* Font::DistanceFieldAtlas::getPageForNewGlyph(const Vector2i& size, Vector2i& cursor_out)
+{
+	if (mPages.size() && mPages.back()->texture->findEmpty(size, cursor_out))
+		return mPages.back();
+
+	// The first page is enough for latin text, the next ones are for large character sets
+	Page* page = new Page();
+	page->texture = new FontTexture();
+	page->texture->textureSize = Vector2i(1024, mPages.size() ? 1024 : 512);
+	page->texture->initTexture();
+	page->pixels.resize(page->texture->textureSize.x() * page->texture->textureSize.y(), 0);
+	mPages.push_back(page);
+
+	LOG(LogDebug) << "Distance field atlas : creating page " << mPages.size() << " for " << Utils::FileSystem::getFileName(mPath);
+
+	if (!page->texture->findEmpty(size, cursor_out))
+		return nullptr;
+
+	return page;
+}
+
+// Propagates the offset to the nearest target pixel (8SSEDT). Offsets of target pixels are 0, others start far away
+static void distanceTransform(std::vector<Vector2i>& grid, int w, int h)
+{
+	auto compare = [&grid, w, h](Vector2i& p, int x, int y, int ox, int oy)
+	{
+		if (x + ox < 0 || y + oy < 0 || x + ox >= w || y + oy >= h)
+			return;
+
+		Vector2i other = grid[(y + oy) * w + x + ox];
+		other[0] += ox;
+		other[1] += oy;
+
+		if (other.x() * other.x() + other.y() * other.y() < p.x() * p.x() + p.y() * p.y())
+			p = other;
+	};
+
+	for (int y = 0; y < h; y++)
+	{
+		for (int x = 0; x < w; x++)
+		{
+			Vector2i& p = grid[y * w + x];
+			compare(p, x, y, -1, 0);
+			compare(p, x, y, 0, -1);
+			compare(p, x, y, -1, -1);
+			compare(p, x, y, 1, -1);
+		}
+
+		for (int x = w - 1; x >= 0; x--)
+			compare(grid[y * w + x], x, y, 1, 0);
+	}
+
+	for (int y = h - 1; y >= 0; y--)
+	{
+		for (int x = w - 1; x >= 0; x--)
+		{
+			Vector2i& p = grid[y * w + x];
+			compare(p, x, y, 1, 0);
+			compare(p, x, y, 0, 1);
+			compare(p, x, y, -1, 1);
+			compare(p, x, y, 1, 1);
+		}
+
+		for (int x = 0; x < w; x++)
+			compare(grid[y * w + x], x, y, -1, 0);
+	}
+}
+
+Font::Glyph* Font::DistanceFieldAtlas::getGlyph(unsigned int id)
+{
+	auto it = mGlyphMap.find(id);
+	if (it != mGlyphMap.cend())
+		return it->second;
+
+	FT_Face face = findFaceForChar(mFaceCache, mPath, DISTANCE_FIELD_SIZE * DISTANCE_FIELD_OVERSAMPLING, id);
+	if (!face || FT_Load_Char(face, id, FT_LOAD_RENDER))
+	{
+		LOG(LogError) << "Could not find glyph for character " << id << " for font " << mPath << " (distance field)";
+		return NULL;
+	}
+
+	FT_GlyphSlot g = face->glyph;
+
+	const int oversampling = DISTANCE_FIELD_OVERSAMPLING;
+	const int spread = DISTANCE_FIELD_SPREAD * oversampling;
+
+	// Field size, in atlas pixels
+	const Vector2i glyphSize((g->bitmap.width + oversampling - 1) / oversampling, (g->bitmap.rows + oversampling - 1) / oversampling);
+	const Vector2i fieldSize(glyphSize.x() + DISTANCE_FIELD_SPREAD * 2, glyphSize.y() + DISTANCE_FIELD_SPREAD * 2);
+
+	// Distances to the nearest inside and outside pixels of the oversampled bitmap
+	const int w = fieldSize.x() * oversampling;
+	const int h = fieldSize.y() * oversampling;
+
+	const Vector2i far(w + h, w + h);
+	std::vector<Vector2i> toInside(w * h, far);
+	std::vector<Vector2i> toOutside(w * h, far);
+	std::vector<bool> inside(w * h, false);
+
+	for (int y = 0; y < (int)g->bitmap.rows; y++)
+	{
+		for (int x = 0; x < (int)g->bitmap.width; x++)
+		{
+			if (g->bitmap.buffer[y * g->bitmap.pitch + x] >= 128)
+				inside[(y + spread) * w + x + spread] = true;
+		}
+	}
+
+	for (int i = 0; i < w * h; i++)
+	{
+		if (inside[i])
+			toInside[i] = Vector2i::Zero();
+		else
+			toOutside[i] = Vector2i::Zero();
+	}
+
+	distanceTransform(toInside, w, h);
+	distanceTransform(toOutside, w, h);
+
+	// Average the signed distances of each oversampled block. 0.5 is the edge, 0 and 1 are DISTANCE_FIELD_SPREAD away
+	std::vector<unsigned char> field(fieldSize.x() * fieldSize.y());
+
+	for (int fy = 0; fy < fieldSize.y(); fy++)
+	{
+		for (int fx = 0; fx < fieldSize.x(); fx++)
+		{
+			float distance = 0.0f;
+
+			for (int sy = 0; sy < oversampling; sy++)
+			{
+				for (int sx = 0; sx < oversampling; sx++)
+				{
+					const int i = (fy * oversampling + sy) * w + fx * oversampling + sx;
+					const Vector2i& d = (inside[i] ? toOutside[i] : toInside[i]);
+					const float length = std::sqrt((float)(d.x() * d.x() + d.y() * d.y())) - 0.5f;
+
+					distance += (inside[i] ? length : -length);
+				}
+			}
+
+			distance /= (float)(oversampling * oversampling * oversampling);
+
+			const float value = 0.5f + distance / (2.0f * DISTANCE_FIELD_SPREAD);
+			field[fy * fieldSize.x() + fx] = (unsigned char)(Math::clamp(value, 0.0f, 1.0f) * 255.0f);
+		}
+	}
+
+	Vector2i cursor;
+	Page* page = getPageForNewGlyph(fieldSize, cursor);
+	if (page == nullptr)
+	{
+		LOG(LogError) << "Could not create glyph for character " << id << " for font " << mPath << " (distance field too large)";
+		return NULL;
+	}
+
+	FontTexture* tex = page->texture;
+
+	for (int y = 0; y < fieldSize.y(); y++)
+		memcpy(&page->pixels[(cursor.y() + y) * tex->textureSize.x() + cursor.x()], &field[y * fieldSize.x()], fieldSize.x());
+
+	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), fieldSize.x(), fieldSize.y(), field.data());
+
+	Glyph* pGlyph = new Glyph();
+	pGlyph->texture = tex;
+	pGlyph->texPos = Vector2f((float)cursor.x() / (float)tex->textureSize.x(), (float)cursor.y() / (float)tex->textureSize.y());
+	pGlyph->texSize = Vector2f((float)fieldSize.x() / (float)tex->textureSize.x(), (float)fieldSize.y() / (float)tex->textureSize.y());
+	pGlyph->advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f) / (float)oversampling;
+	pGlyph->bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f) / (float)oversampling;
+	pGlyph->cursor = cursor;
+	pGlyph->glyphSize = glyphSize;
+	pGlyph->padding = DISTANCE_FIELD_SPREAD;
+
+	mGlyphMap[id] = pGlyph;
+	return pGlyph;
+}
+
+//=============================================================================================================
+//Glyph prewarm
+//=============================================================================================================
+
+typedef std::pair<std::string, int> FontKey; // path, size
+
+struct PrewarmedGlyph
+{
+	std::vector<unsigned char> pixels;
+	Vector2i size;
+	Vector2f advance;
+	Vector2f bearing;
+};
+
+static std::mutex sPrewarmLock;
+static std::condition_variable sPrewarmEvent;
+static std::thread* sPrewarmThread = nullptr;
+static bool sPrewarmExit = false;
+
+static std::vector<unsigned int> sPrewarmChars; // Codepoints of the gamelists, in order of appearance
+struct PrewarmProgress
+{
+	PrewarmProgress() : done(0), bytes(0) { }
+
+	size_t done; // sPrewarmChars already rasterized
+	size_t bytes; // waiting in sPrewarmedGlyphs
+};
+
+static std::map<FontKey, PrewarmProgress> sPrewarmProgress; // Fonts in use
+static std::map<FontKey, std::map<unsigned int, PrewarmedGlyph>> sPrewarmedGlyphs;
+static std::atomic<size_t> sPrewarmedBytes(0);
+
+// Advances of non latin glyphs, saved between runs
+static std::map<FontKey, std::unordered_map<unsigned int, float>> sGlyphAdvances;
+static bool sGlyphAdvancesDirty = false;
+
+static std::string getGlyphCacheFilename()
+{
+	return Utils::FileSystem::getEsConfigPath() + "/fontcache.bin";
+}
+
+void Font::prewarmGlyphs(const std::vector<std::string>& texts)
+{
+	std::set<unsigned int> known;
+
+	{
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+		known.insert(sPrewarmChars.cbegin(), sPrewarmChars.cend());
+	}
+
+	std::vector<unsigned int> chars;
+
+	for (auto& text : texts)
+	{
+		size_t i = 0;
+		while (i < text.length())
+		{
+			unsigned int character = Utils::String::chars2Unicode(text, i); // advances i
+
+			// Latin glyphs are few and quickly rasterized when first drawn
+			if (character > 0xFF && known.insert(character).second)
+				chars.push_back(character);
+		}
+	}
+
+	if (chars.size() == 0)
+		return;
+
+	LOG(LogDebug) << "Font::prewarmGlyphs\tQueuing " << chars.size() << " characters";
+
+	{
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+		sPrewarmChars.insert(sPrewarmChars.end(), chars.cbegin(), chars.cend());
+
+		if (sPrewarmThread == nullptr)
+		{
+			sPrewarmExit = false;
+			sPrewarmThread = new std::thread(&Font::prewarmThread);
+		}
+	}
+
+	sPrewarmEvent.notify_one();
+}
+
+void Font::stopGlyphPrewarm()
+{
+	{
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+		if (sPrewarmThread == nullptr)
+			return;
+
+		sPrewarmExit = true;
+	}
+
+	sPrewarmEvent.notify_one();
+	sPrewarmThread->join();
+
+	delete sPrewarmThread;
+	sPrewarmThread = nullptr;
+
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+	sPrewarmedGlyphs.clear();
+	sPrewarmedBytes = 0;
+}
+
+void Font::prewarmThread()
+{
+	// FreeType libraries can't be shared between threads : the worker has its own, and its own faces
+	FT_Library library;
+	if (FT_Init_FreeType(&library))
+	{
+		LOG(LogError) << "Font::prewarmThread\tError initializing FreeType";
+		return;
+	}
+
+	FontKey faceKey;
+	std::map< unsigned int, std::unique_ptr<FontFace> > faceCache;
+
+	while (true)
+	{
+		FontKey key;
+		std::vector<unsigned int> batch;
+
+		{
+			std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+			while (!sPrewarmExit)
+			{
+				for (auto& progress : sPrewarmProgress)
+				{
+					if (progress.second.done >= sPrewarmChars.size() || progress.second.bytes >= PREWARM_FONT_MAX_BYTES)
+						continue;
+
+					size_t count = std::min(sPrewarmChars.size() - progress.second.done, (size_t)PREWARM_BATCH_SIZE);
+
+					key = progress.first;
+					batch.assign(sPrewarmChars.cbegin() + progress.second.done, sPrewarmChars.cbegin() + progress.second.done + count);
+					progress.second.done += count;
+					break;
+				}
+
+				if (batch.size())
+					break;
+
+				sPrewarmEvent.wait(lock);
+			}
+
+			if (sPrewarmExit)
+				break;
+		}
+
+		if (key != faceKey)
+		{
+			faceCache.clear();
+			faceKey = key;
+		}
+
+		std::map<unsigned int, PrewarmedGlyph> glyphs;
+		size_t bytes = 0;
+
+		for (auto id : batch)
+		{
+			FT_Face face = findFaceForChar(faceCache, key.first, key.second, id, library);
+			if (face == nullptr || FT_Load_Char(face, id, FT_LOAD_RENDER))
+				continue;
+
+			FT_GlyphSlot g = face->glyph;
+
+			PrewarmedGlyph& glyph = glyphs[id];
+			glyph.size = Vector2i(g->bitmap.width, g->bitmap.rows);
+			glyph.advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
+			glyph.bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+
+			// FreeType rows may be padded, keep them packed like the texture upload expects
+			glyph.pixels.resize(glyph.size.x() * glyph.size.y());
+			for (int y = 0; y < glyph.size.y(); y++)
+				memcpy(&glyph.pixels[y * glyph.size.x()], &g->bitmap.buffer[y * g->bitmap.pitch], glyph.size.x());
+
+			bytes += glyph.pixels.size();
+		}
+
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+		// The font may have been deleted meanwhile
+		auto progress = sPrewarmProgress.find(key);
+		if (progress == sPrewarmProgress.cend())
+			continue;
+
+		auto& advances = sGlyphAdvances[key];
+		auto& prewarmed = sPrewarmedGlyphs[key];
+
+		for (auto& glyph : glyphs)
+		{
+			advances[glyph.first] = glyph.second.advance.x();
+			prewarmed[glyph.first] = std::move(glyph.second);
+		}
+
+		progress->second.bytes += bytes;
+		sPrewarmedBytes += bytes;
+		sGlyphAdvancesDirty = true;
+	}
+
+	faceCache.clear();
+	FT_Done_FreeType(library);
+}
+
+static bool takePrewarmedGlyph(const FontKey& key, unsigned int id, PrewarmedGlyph& glyph)
+{
+	if (sPrewarmedBytes == 0)
+		return false;
+
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+	auto it = sPrewarmedGlyphs.find(key);
+	if (it == sPrewarmedGlyphs.cend())
+		return false;
+
+	auto git = it->second.find(id);
+	if (git == it->second.cend())
+		return false;
+
+	glyph = std::move(git->second);
+	it->second.erase(git);
+
+	sPrewarmedBytes -= glyph.pixels.size();
+
+	auto progress = sPrewarmProgress.find(key);
+	if (progress != sPrewarmProgress.cend())
+		progress->second.bytes -= glyph.pixels.size();
+
+	// Room for more glyphs
+	sPrewarmEvent.notify_one();
+	return true;
+}
+
+static void registerPrewarmFont(const FontKey& key)
+{
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+	sPrewarmProgress[key] = PrewarmProgress();
+	sPrewarmEvent.notify_one();
+}
+
+static void unregisterPrewarmFont(const FontKey& key)
+{
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+	sPrewarmProgress.erase(key);
+
+	auto it = sPrewarmedGlyphs.find(key);
+	if (it == sPrewarmedGlyphs.cend())
+		return;
+
+	for (auto& glyph : it->second)
+		sPrewarmedBytes -= glyph.second.pixels.size();
+
+	sPrewarmedGlyphs.erase(it);
+}
+
+void Font::loadGlyphCache()
+{
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+	sGlyphAdvances.clear();
+	sGlyphAdvancesDirty = false;
+
+	std::string fname = getGlyphCacheFilename();
+
+	FILE* file = fopen(fname.c_str(), "rb");
+	if (file == nullptr)
+		return;
+
+	char magic[4];
+	uint32_t version = 0;
+
+	if (fread(magic, 1, 4, file) != 4 || memcmp(magic, GLYPHCACHE_MAGIC, 4) != 0 || fread(&version, sizeof(version), 1, file) != 1 || version != GLYPHCACHE_VERSION)
+	{
+		fclose(file);
+		return;
+	}
+
+	// Records : path length, path, font size, advances count, then (character, advance) pairs
+	uint16_t len;
+	while (fread(&len, sizeof(len), 1, file) == 1)
+	{
+		std::string path(len, '\0');
+		int32_t size;
+		uint32_t count;
+
+		if (fread(&path[0], 1, len, file) != len || fread(&size, sizeof(size), 1, file) != 1 || fread(&count, sizeof(count), 1, file) != 1)
+			break;
+
+		auto& advances = sGlyphAdvances[FontKey(path, size)];
+
+		uint32_t id;
+		float advance;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (fread(&id, sizeof(id), 1, file) != 1 || fread(&advance, sizeof(advance), 1, file) != 1)
+				break;
+
+			advances[id] = advance;
+		}
+	}
+
+	fclose(file);
+}
+
+void Font::saveGlyphCache()
+{
+	stopGlyphPrewarm();
+
+	std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+	if (!sGlyphAdvancesDirty)
+		return;
+
+	std::string fname = getGlyphCacheFilename();
+
+	FILE* file = fopen(fname.c_str(), "wb");
+	if (file == nullptr)
+		return;
+
+	uint32_t version = GLYPHCACHE_VERSION;
+	fwrite(GLYPHCACHE_MAGIC, 1, 4, file);
+	fwrite(&version, sizeof(version), 1, file);
+
+	for (auto& font : sGlyphAdvances)
+	{
+		if (font.second.size() == 0 || font.first.first.size() > 0xFFFF)
+			continue;
+
+		uint16_t len = (uint16_t)font.first.first.size();
+		int32_t size = font.first.second;
+		uint32_t count = (uint32_t)font.second.size();
+
+		fwrite(&len, sizeof(len), 1, file);
+		fwrite(font.first.first.c_str(), 1, len, file);
+		fwrite(&size, sizeof(size), 1, file);
+		fwrite(&count, sizeof(count), 1, file);
+
+		for (auto& advance : font.second)
+		{
+			uint32_t id = advance.first;
+			fwrite(&id, sizeof(id), 1, file);
+			fwrite(&advance.second, sizeof(float), 1, file);
+		}
+	}
+
+	fclose(file);
+	sGlyphAdvancesDirty = false;
+}
+
+float Font::getGlyphAdvance(unsigned int id)
+{
+	Glyph* glyph = (id < 255 ? mGlyphCacheArray[id] : nullptr);
+	if (glyph != nullptr)
+		return glyph->advance.x();
+
+	auto it = mGlyphMap.find(id);
+	if (it != mGlyphMap.cend())
+		return it->second->advance.x();
+
+	// Measure non latin text from the cached metrics, it will be rasterized when drawn
+	if (id > 0xFF && !mDistanceField)
+	{
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+		auto fit = sGlyphAdvances.find(FontKey(mPath, mSize));
+		if (fit != sGlyphAdvances.cend())
+		{
+			auto ait = fit->second.find(id);
+			if (ait != fit->second.cend())
+				return ait->second;
+		}
+	}
+
+	glyph = getGlyph(id);
+	return glyph != nullptr ? glyph->advance.x() : 0.0f;
+}
+
 FT_Library Font::sLibrary = NULL;
 
 int Font::getSize() const { return mSize; }
@@ -24,9 +717,9 @@ int Font::getSize() const { return mSize; }
 std::map< std::pair<std::string, int>, std::weak_ptr<Font> > Font::sFontMap;
 static std::map<unsigned int, std::string> substituableChars;
 
-Font::FontFace::FontFace(ResourceData&& d, int size) : data(d)
+Font::FontFace::FontFace(ResourceData&& d, int size, FT_Library library) : data(d)
 {
-	int err = FT_New_Memory_Face(sLibrary, data.ptr.get(), (FT_Long)data.length, 0, &face);
+	int err = FT_New_Memory_Face(library != nullptr ? library : sLibrary, data.ptr.get(), (FT_Long)data.length, 0, &face);
 	if (!err)
 		FT_Set_Pixel_Sizes(face, 0, size);
 }
@@ -79,6 +772,9 @@ size_t Font::getTotalMemUsage()
 		it++;
 	}
 
+	// Distance field atlases are shared by several fonts
+	total += DistanceFieldAtlas::getTotalMemUsage();
+
 	return total;
 }
 
@@ -100,6 +796,14 @@ Font::Font(int size, const std::string& path) : mSize(size), mPath(path)
 	if (mSize == 0)
 		mSize = 2;
 
+	if (Settings::getInstance()->getBool("FontDistanceField") && Renderer::isDistanceFieldSupported())
+	{
+		mDistanceField = DistanceFieldAtlas::get(mPath);
+		mDistanceField->acquire();
+	}
+	else
+		registerPrewarmFont(FontKey(mPath, mSize));
+
 	mLoaded = true;
 	mMaxGlyphHeight = 0;
 
@@ -120,6 +824,9 @@ Font::~Font()
 {
 	unload();
 
+	if (!mDistanceField)
+		unregisterPrewarmFont(FontKey(mPath, mSize));
+
 	for (auto tex : mTextures)
 		delete tex;
 
@@ -146,6 +853,9 @@ bool Font::unload()
 		for (auto tex : mTextures)
 			tex->deinitTexture();
 
+		if (mDistanceField)
+			mDistanceField->release();
+
 		clearFaceCache();
 
 		mLoaded = false;
@@ -177,8 +887,6 @@ Font::FontTexture::FontTexture()
 {
 	textureId = 0;
 	textureSize = Vector2i(2048, 512);
-	writePos = Vector2i::Zero();
-	rowHeight = 0;
 }
 
 Font::FontTexture::~FontTexture()
@@ -191,25 +899,80 @@ bool Font::FontTexture::findEmpty(const Vector2i& size, Vector2i& cursor_out)
 	if(size.x() >= textureSize.x() || size.y() >= textureSize.y())
 		return false;
 
-	if(writePos.x() + size.x() >= textureSize.x() && writePos.y() + rowHeight + size.y() + 1 < textureSize.y())
+	if (skyline.empty())
+		skyline.push_back({ 0, 0, textureSize.x() });
+
+	// leave 1px of space between glyphs
+	const int width = size.x() + 1;
+	const int height = size.y() + 1;
+
+	// Bottom-left rule : lowest position, then the narrowest segment to limit wasted space
+	int bestIndex = -1;
+	int bestY = textureSize.y();
+	int bestWidth = textureSize.x();
+
+	for (int i = 0; i < (int)skyline.size(); i++)
 	{
-		// row full, but it should fit on the next row
-		// move cursor to next row
-		writePos = Vector2i(0, writePos.y() + rowHeight + 1); // leave 1px of space between glyphs
-		rowHeight = 0;
+		if (skyline[i].x + width > textureSize.x())
+			break;
+
+		// The glyph rests on the highest segment it spans
+		int y = 0;
+		int remaining = width;
+
+		for (int j = i; remaining > 0 && j < (int)skyline.size(); j++)
+		{
+			y = Math::max(y, skyline[j].y);
+			remaining -= skyline[j].width;
+		}
+
+		if (remaining > 0 || y + height > textureSize.y())
+			continue;
+
+		if (y < bestY || (y == bestY && skyline[i].width < bestWidth))
+		{
+			bestIndex = i;
+			bestY = y;
+			bestWidth = skyline[i].width;
+		}
 	}
 
-	if(writePos.x() + size.x() >= textureSize.x() || writePos.y() + size.y() >= textureSize.y())
-	{
-		// nope, still won't fit
+	if (bestIndex < 0)
 		return false;
-	}
 
-	cursor_out = writePos;
-	writePos[0] += size.x() + 1; // leave 1px of space between glyphs
+	cursor_out = Vector2i(skyline[bestIndex].x, bestY);
+
+	SkylineNode node = { skyline[bestIndex].x, bestY + height, width };
+	skyline.insert(skyline.begin() + bestIndex, node);
+
+	// Cut the segments now covered by the glyph
+	for (int i = bestIndex + 1; i < (int)skyline.size(); )
+	{
+		const int previousEnd = skyline[i - 1].x + skyline[i - 1].width;
+		if (skyline[i].x >= previousEnd)
+			break;
+
+		const int overlap = previousEnd - skyline[i].x;
+		skyline[i].x += overlap;
+		skyline[i].width -= overlap;
+
+		if (skyline[i].width > 0)
+			break;
+
+		skyline.erase(skyline.begin() + i);
+	}
 
-	if(size.y() > rowHeight)
-		rowHeight = size.y();
+	// Merge neighbours at the same height
+	for (int i = 0; i + 1 < (int)skyline.size(); )
+	{
+		if (skyline[i].y == skyline[i + 1].y)
+		{
+			skyline[i].width += skyline[i + 1].width;
+			skyline.erase(skyline.begin() + i + 1);
+		}
+		else
+			i++;
+	}
 
 	return true;
 }
@@ -254,6 +1017,10 @@ void Font::getTextureForNewGlyph(const Vector2i& glyphSize, FontTexture*& tex_ou
 	int x = Math::min(2048, mSize * 64);
 	int y = Math::min(2048, Math::max(glyphSize.y(), mSize) + 2) * 1.2;
 
+	// The first page is sized for latin text. If more are needed, the text uses large character sets (CJK...) : use taller pages
+	if (mTextures.size())
+		y = Math::max(y, Math::min(2048, x / 4));
+
 	tex->textureSize = Vector2i(x, y);
 	tex->initTexture();
 
@@ -291,22 +1058,27 @@ std::vector<std::string> getFallbackFontPaths()
 }
 
 FT_Face Font::getFaceForChar(unsigned int id)
+{
+	return findFaceForChar(mFaceCache, mPath, mSize, id);
+}
+
+FT_Face Font::findFaceForChar(std::map< unsigned int, std::unique_ptr<FontFace> >& faceCache, const std::string& fontPath, int size, unsigned int id, FT_Library library)
 {
 	static const std::vector<std::string> fallbackFonts = getFallbackFontPaths();
 
 	// look through our current font + fallback fonts to see if any have the glyph we're looking for
 	for(unsigned int i = 0; i < fallbackFonts.size() + 1; i++)
 	{
-		auto fit = mFaceCache.find(i);
+		auto fit = faceCache.find(i);
 
-		if(fit == mFaceCache.cend()) // doesn't exist yet
+		if(fit == faceCache.cend()) // doesn't exist yet
 		{
-			// i == 0 -> mPath
+			// i == 0 -> fontPath
 			// otherwise, take from fallbackFonts
-			const std::string& path = (i == 0 ? mPath : fallbackFonts.at(i - 1));
+			const std::string& path = (i == 0 ? fontPath : fallbackFonts.at(i - 1));
 			ResourceData data = ResourceManager::getInstance()->getFileData(path);
-			mFaceCache[i] = std::unique_ptr<FontFace>(new FontFace(std::move(data), mSize));
-			fit = mFaceCache.find(i);
+			faceCache[i] = std::unique_ptr<FontFace>(new FontFace(std::move(data), size, library));
+			fit = faceCache.find(i);
 		}
 
 		if(FT_Get_Char_Index(fit->second->face, id) != 0)
@@ -314,12 +1086,15 @@ FT_Face Font::getFaceForChar(unsigned int id)
 	}
 
 	// nothing has a valid glyph - return the "real" face so we get a "missing" character
-	return mFaceCache.cbegin()->second->face;
+	return faceCache.cbegin()->second->face;
 }
 
 void Font::clearFaceCache()
 {
 	mFaceCache.clear();
+
+	if (mDistanceField)
+		mDistanceField->clearFaceCache();
 }
 
 Font::Glyph* Font::getGlyph(unsigned int id)
@@ -341,6 +1116,36 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	}
 
 	// nope, need to make a glyph
+	if (mDistanceField)
+	{
+		Glyph* field = mDistanceField->getGlyph(id);
+		if (field == NULL)
+			return NULL;
+
+		// Same texture area, scaled to this size
+		const float scale = (float)mSize / (float)DISTANCE_FIELD_SIZE;
+
+		Glyph* pGlyph = new Glyph(*field);
+		pGlyph->advance = field->advance * scale;
+		pGlyph->bearing = field->bearing * scale;
+		pGlyph->glyphSize = Vector2i(Math::round(field->glyphSize.x() * scale), Math::round(field->glyphSize.y() * scale));
+		pGlyph->padding = field->padding * scale;
+
+		if (pGlyph->glyphSize.y() > mMaxGlyphHeight)
+			mMaxGlyphHeight = pGlyph->glyphSize.y();
+
+		mGlyphMap[id] = pGlyph;
+
+		if (id < 255)
+			mGlyphCacheArray[id] = pGlyph;
+
+		return pGlyph;
+	}
+
+	PrewarmedGlyph prewarmed;
+	if (takePrewarmedGlyph(FontKey(mPath, mSize), id, prewarmed))
+		return addGlyph(id, prewarmed.size, prewarmed.pixels.data(), prewarmed.advance, prewarmed.bearing);
+
 	FT_Face face = getFaceForChar(id);
 	if(!face)
 	{
@@ -356,8 +1161,26 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 		return NULL;
 	}
 
-	Vector2i glyphSize(g->bitmap.width, g->bitmap.rows);
+	Vector2f advance((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
+	Vector2f bearing((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);
+
+	if (id > 0xFF)
+	{
+		std::unique_lock<std::mutex> lock(sPrewarmLock);
+
+		auto& advances = sGlyphAdvances[FontKey(mPath, mSize)];
+		if (advances.find(id) == advances.cend())
+		{
+			advances[id] = advance.x();
+			sGlyphAdvancesDirty = true;
+		}
+	}
+
+	return addGlyph(id, Vector2i(g->bitmap.width, g->bitmap.rows), g->bitmap.buffer, advance, bearing);
+}
 
+Font::Glyph* Font::addGlyph(unsigned int id, const Vector2i& glyphSize, const unsigned char* pixels, const Vector2f& advance, const Vector2f& bearing)
+{
 	FontTexture* tex = NULL;
 	Vector2i cursor;
 	getTextureForNewGlyph(glyphSize, tex, cursor);
@@ -375,13 +1198,14 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 	pGlyph->texture = tex;
 	pGlyph->texPos = Vector2f((float)cursor.x() / (float)tex->textureSize.x(), (float)cursor.y() / (float)tex->textureSize.y());
 	pGlyph->texSize = Vector2f((float)glyphSize.x() / (float)tex->textureSize.x(), (float)glyphSize.y() / (float)tex->textureSize.y());
-	pGlyph->advance = Vector2f((float)g->metrics.horiAdvance / 64.0f, (float)g->metrics.vertAdvance / 64.0f);
-	pGlyph->bearing = Vector2f((float)g->metrics.horiBearingX / 64.0f, (float)g->metrics.horiBearingY / 64.0f);	
+	pGlyph->advance = advance;
+	pGlyph->bearing = bearing;
 	pGlyph->cursor = cursor;
 	pGlyph->glyphSize = glyphSize;
+	pGlyph->padding = 0.0f;
 
 	// upload glyph bitmap to texture
-	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), g->bitmap.buffer);
+	Renderer::updateTexture(tex->textureId, Renderer::Texture::ALPHA, cursor.x(), cursor.y(), glyphSize.x(), glyphSize.y(), (void*)pixels);
 
 	// update max glyph height
 	if(glyphSize.y() > mMaxGlyphHeight)
@@ -399,6 +1223,12 @@ Font::Glyph* Font::getGlyph(unsigned int id)
 // completely recreate the texture data for all textures based on mGlyphs information
 void Font::rebuildTextures()
 {
+	if (mDistanceField)
+	{
+		mDistanceField->acquire();
+		return;
+	}
+
 	// recreate OpenGL textures
 	for(auto tex : mTextures)
 		tex->initTexture();
@@ -432,6 +1262,9 @@ void Font::renderTextCache(TextCache* cache)
 
 	int tex = -1;
 
+	if (cache->distanceField > 0.0f)
+		Renderer::setDistanceField(cache->distanceField);
+
 	for(auto& vertex : cache->vertexLists)
 	{		
 		if (vertex.textureIdPtr == nullptr)
@@ -443,10 +1276,35 @@ void Font::renderTextCache(TextCache* cache)
 			Renderer::bindTexture(tex);			
 		}
 
-		if (tex != 0)
+		if (tex == 0)
+			continue;
+
+		// Long texts are kept in a static vertex buffer. Short ones are merged in the renderer's draw batches
+		bool drawn = false;
+
+		if (vertex.verts.size() >= STATIC_TEXT_MIN_VERTICES)
+		{
+			if (vertex.vertexBuffer != 0)
+				drawn = Renderer::drawStaticVertexBuffer(vertex.vertexBuffer, vertex.verts.size());
+
+			if (!drawn)
+			{
+				// Not created yet, or lost with a renderer reinit
+				Renderer::destroyStaticVertexBuffer(vertex.vertexBuffer);
+				vertex.vertexBuffer = Renderer::createStaticVertexBuffer(&vertex.verts[0], vertex.verts.size());
+
+				if (vertex.vertexBuffer != 0)
+					drawn = Renderer::drawStaticVertexBuffer(vertex.vertexBuffer, vertex.verts.size());
+			}
+		}
+
+		if (!drawn)
 			Renderer::drawTriangleStrips(&vertex.verts[0], vertex.verts.size());
 	}
 
+	if (cache->distanceField > 0.0f)
+		Renderer::setDistanceField(0.0f);
+
 	if (cache->renderingGlow)
 		return;
 
@@ -462,6 +1320,7 @@ void Font::renderTextCache(TextCache* cache)
 					sub.vertex[3].pos.x() - sub.vertex[0].pos.x(), 
 					0xFF000033, 0xFF000033);
 
+			sub.texture->mapTextureCoords(&sub.vertex[0], 4);
 			Renderer::drawTriangleStrips(&sub.vertex[0], 4);
 		}
 	}
@@ -518,10 +1377,22 @@ void Font::renderGradientTextCache(TextCache* cache, unsigned int colorTop, unsi
 		}
 
 		Renderer::bindTexture(*it->textureIdPtr);
+		Renderer::setDistanceField(cache->distanceField);
 		Renderer::drawTriangleStrips(&vxs[0], vxs.size());		
+		Renderer::setDistanceField(0.0f);
 	}
 }
 
+float Font::getDistanceFieldSmoothing() const
+{
+	if (!mDistanceField)
+		return 0.0f;
+
+	// Half a screen pixel around the edge, in distance field values
+	const float scale = (float)mSize / (float)DISTANCE_FIELD_SIZE;
+	return Math::min(0.5f, 0.25f / (DISTANCE_FIELD_SPREAD * scale));
+}
+
 std::string tryFastBidi(const std::string& text)
 {
 	std::string ret = "";
@@ -611,9 +1482,7 @@ Vector2f Font::sizeText(std::string text, float lineSpacing)
 			y += lineHeight;
 		}
 
-		Glyph* glyph = getGlyph(character);
-		if(glyph)
-			lineWidth += glyph->advance.x();
+		lineWidth += getGlyphAdvance(character);
 	}
 
 	if(lineWidth > highestWidth)
@@ -636,40 +1505,77 @@ float Font::getLetterHeight()
 	return mSize;
 }
 
-//the worst algorithm ever written
+// Width of text appended to a line of lineWidth, where the previous lines of the same block are up to highestWidth wide
+void Font::measureText(const std::string& text, size_t start, size_t end, float lineHeight, float& lineWidth, float& highestWidth)
+{
+	size_t i = start;
+	while (i < end)
+	{
+		unsigned int character = Utils::String::chars2Unicode(text, i); // advances i
+
+		if (substituableChars.find(character) != substituableChars.cend())
+		{
+			lineWidth += lineHeight;
+			continue;
+		}
+
+		if (character == '\n')
+		{
+			if (lineWidth > highestWidth)
+				highestWidth = lineWidth;
+
+			lineWidth = 0.0f;
+		}
+
+		lineWidth += getGlyphAdvance(character);
+	}
+}
+
 //breaks up a normal string with newlines to make it fit xLen
 std::string Font::wrapText(std::string text, float xLen)
 {
-	std::string out;
+	return getTextLayout(text, xLen).wrapped;
+}
 
-	std::string line, word, temp;
-	size_t space;
+std::string Font::layoutText(const std::string& text, float xLen)
+{
+	std::string out;
+	std::string line;
 
-	Vector2f textSize;
+	// widths of the pending line, measured word by word instead of sizing the whole line again
+	const float lineHeight = getHeight();
+	float lineWidth = 0.0f;
+	float highestWidth = 0.0f;
 
-	while(text.length() > 0) //while there's text or we still have text to render
+	size_t pos = 0;
+	while (pos < text.length())
 	{
-		space = text.find_first_of(" \t\n");
-		if(space == std::string::npos)
+		size_t space = text.find_first_of(" \t\n", pos);
+		if (space == std::string::npos)
 			space = text.length() - 1;
 
-		word = text.substr(0, space + 1);
-		text.erase(0, space + 1);
-
-		temp = line + word;
-
-		textSize = sizeText(temp);
+		float width = lineWidth;
+		float highest = highestWidth;
+		measureText(text, pos, space + 1, lineHeight, width, highest);
 
 		// if the word will fit on the line, add it to our line, and continue
-		if(textSize.x() <= xLen)
+		if (Math::max(width, highest) <= xLen)
+		{
+			line.append(text, pos, space + 1 - pos);
+			lineWidth = width;
+			highestWidth = highest;
+		}
+		else
 		{
-			line = temp;
-			continue;
-		}else{
 			// the next word won't fit, so break here
 			out += line + '\n';
-			line = word;
+			line = text.substr(pos, space + 1 - pos);
+
+			lineWidth = highestWidth = 0.0f;
+			measureText(line, 0, line.length(), lineHeight, lineWidth, highestWidth);
 		}
+
+		pos = space + 1;
 	}
 
 	// whatever's left should fit
@@ -678,15 +1584,59 @@ std::string Font::wrapText(std::string text, float xLen)
 	return out;
 }
 
+Font::TextLayout& Font::getTextLayout(const std::string& text, float xLen)
+{
+	const size_t key = std::hash<std::string>()(text) ^ (std::hash<float>()(xLen) * 31);
+
+	auto it = mLayoutIndex.find(key);
+	if (it != mLayoutIndex.cend())
+	{
+		if (it->second->xLen == xLen && it->second->text == text)
+		{
+			// most recently used first
+			mLayoutCache.splice(mLayoutCache.begin(), mLayoutCache, it->second);
+			return *it->second;
+		}
+
+		// hash collision : replace the entry
+		mLayoutCache.erase(it->second);
+		mLayoutIndex.erase(it);
+	}
+
+	if (mLayoutCache.size() >= TEXT_LAYOUT_CACHE_SIZE)
+	{
+		mLayoutIndex.erase(mLayoutCache.back().key);
+		mLayoutCache.pop_back();
+	}
+
+	TextLayout layout;
+	layout.key = key;
+	layout.text = text;
+	layout.xLen = xLen;
+	layout.wrapped = layoutText(text, xLen);
+
+	mLayoutCache.push_front(std::move(layout));
+	mLayoutIndex[key] = mLayoutCache.begin();
+
+	return mLayoutCache.front();
+}
+
 Vector2f Font::sizeWrappedText(std::string text, float xLen, float lineSpacing)
 {
-	text = wrapText(text, xLen);
-	return sizeText(text, lineSpacing);
+	TextLayout& layout = getTextLayout(text, xLen);
+
+	for (auto& size : layout.sizes)
+		if (size.first == lineSpacing)
+			return size.second;
+
+	Vector2f size = sizeText(layout.wrapped, lineSpacing);
+	layout.sizes.push_back(std::pair<float, Vector2f>(lineSpacing, size));
+	return size;
 }
 
 Vector2f Font::getWrappedTextCursorOffset(std::string text, float xLen, size_t stop, float lineSpacing)
 {
-	std::string wrappedText = wrapText(text, xLen);
+	const std::string& wrappedText = getTextLayout(text, xLen).wrapped;
 
 	float lineWidth = 0.0f;
 	float y = 0.0f;
@@ -897,17 +1847,21 @@ TextCache* Font::buildTextCache(const std::string& _text, Vector2f offset, unsig
 		verts.resize(oldVertSize + 6);
 		Renderer::Vertex* vertices = verts.data() + oldVertSize;
 
-		const float        glyphStartX    = x + glyph->bearing.x();
+		const float        glyphStartX    = x + glyph->bearing.x() - glyph->padding;
+		const float        glyphStartY    = y - glyph->bearing.y() - glyph->padding;
+		const float        glyphWidth     = glyph->glyphSize.x() + glyph->padding * 2.0f;
+		const float        glyphHeight    = glyph->glyphSize.y() + glyph->padding * 2.0f;
 		const unsigned int convertedColor = Renderer::convertColor(color);
 
-		vertices[1] = { { glyphStartX                                       , y - glyph->bearing.y()                                          }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, convertedColor };
-		vertices[2] = { { glyphStartX                                       , y - glyph->bearing.y() + (glyph->glyphSize.y())                 }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
-		vertices[3] = { { glyphStartX + glyph->glyphSize.x()                , y - glyph->bearing.y()                                          }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, convertedColor };
-		vertices[4] = { { glyphStartX + glyph->glyphSize.x()                , y - glyph->bearing.y() + (glyph->glyphSize.y())                 }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
+		vertices[1] = { { glyphStartX                                       , glyphStartY                                                     }, { glyph->texPos.x(),                      glyph->texPos.y()                      }, convertedColor };
+		vertices[2] = { { glyphStartX                                       , glyphStartY + glyphHeight                                       }, { glyph->texPos.x(),                      glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
+		vertices[3] = { { glyphStartX + glyphWidth                          , glyphStartY                                                     }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y()                      }, convertedColor };
+		vertices[4] = { { glyphStartX + glyphWidth                          , glyphStartY + glyphHeight                                       }, { glyph->texPos.x() + glyph->texSize.x(), glyph->texPos.y() + glyph->texSize.y() }, convertedColor };
 
-		// round vertices
-		for(int i = 1; i < 5; ++i)
-			vertices[i].pos.round();
+		// round vertices. Distance fields are not pixel aligned bitmaps : rounding would only distort their scale
+		if (!mDistanceField)
+			for(int i = 1; i < 5; ++i)
+				vertices[i].pos.round();
 
 		// make duplicates of first and last vertex so this can be rendered as a triangle strip
 		vertices[0] = vertices[1];
@@ -920,6 +1874,7 @@ TextCache* Font::buildTextCache(const std::string& _text, Vector2f offset, unsig
 	//TextCache::CacheMetrics metrics = { sizeText(text, lineSpacing) };
 
 	TextCache* cache = new TextCache();
+	cache->distanceField = getDistanceFieldSmoothing();
 	cache->vertexLists.resize(vertMap.size());
 	cache->metrics = { sizeText(text, lineSpacing) };
 	cache->imageSubstitutes = imageSubstitutes;
@@ -944,13 +1899,28 @@ TextCache* Font::buildTextCache(const std::string& text, float offsetX, float of
 	return buildTextCache(text, Vector2f(offsetX, offsetY), color, 0.0f);
 }
 
+TextCache::~TextCache()
+{
+	for (auto& vertex : vertexLists)
+		Renderer::destroyStaticVertexBuffer(vertex.vertexBuffer);
+}
+
 void TextCache::setColor(unsigned int color)
 {
 	const unsigned int convertedColor = Renderer::convertColor(color);
 
 	for(auto it = vertexLists.begin(); it != vertexLists.end(); it++)
+	{
+		// Components set the color on every frame : only rebuild the vertex buffer if it really changed
+		if (it->verts.empty() || it->verts[0].col == convertedColor)
+			continue;
+
 		for(auto it2 = it->verts.begin(); it2 != it->verts.end(); it2++)
 			it2->col = convertedColor;
+
+		Renderer::destroyStaticVertexBuffer(it->vertexBuffer);
+		it->vertexBuffer = 0;
+	}
 }
 
 std::shared_ptr<Font> Font::getFromTheme(const ThemeData::ThemeElement* elem, unsigned int properties, const std::shared_ptr<Font>& orig)
@@ -9,6 +9,8 @@
 #include "ThemeData.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 class TextCache;
@@ -76,6 +78,14 @@ public:
 	size_t getMemUsage() const; // returns an approximation of VRAM used by this font's texture (in bytes)
 	static size_t getTotalMemUsage(); // returns an approximation of total VRAM used by font textures (in bytes)
 
+	// Rasterizes the non latin characters of these texts on a worker thread, for all the fonts in use
+	static void prewarmGlyphs(const std::vector<std::string>& texts);
+	static void stopGlyphPrewarm();
+
+	// Advances of non latin glyphs are kept between runs, to measure text before its glyphs are rasterized
+	static void loadGlyphCache();
+	static void saveGlyphCache();
+
 private:
 	static FT_Library sLibrary;
 	static std::map< std::pair<std::string, int>, std::weak_ptr<Font> > sFontMap;
@@ -88,9 +98,6 @@ private:
 		unsigned int textureId;
 		Vector2i textureSize;
 
-		Vector2i writePos;
-		int rowHeight;
-
 		FontTexture();
 		~FontTexture();
 		bool findEmpty(const Vector2i& size, Vector2i& cursor_out);
@@ -98,6 +105,17 @@ private:
 		// you must call initTexture() after creating a FontTexture to get a textureId
 		void initTexture(); // initializes the OpenGL texture according to this FontTexture's settings, updating textureId
 		void deinitTexture(); // deinitializes the OpenGL texture if any exists, is automatically called in the destructor
+
+	private:
+		// Skyline packing : top of the used area, as horizontal segments from left to right
+		struct SkylineNode
+		{
+			int x;
+			int y;
+			int width;
+		};
+
+		std::vector<SkylineNode> skyline;
 	};
 
 	struct FontFace
@@ -105,7 +123,7 @@ private:
 		const ResourceData data;
 		FT_Face face;
 
-		FontFace(ResourceData&& d, int size);
+		FontFace(ResourceData&& d, int size, FT_Library library = nullptr);
 		virtual ~FontFace();
 	};
 
@@ -119,6 +137,9 @@ private:
 	FT_Face getFaceForChar(unsigned int id);
 	void clearFaceCache();
 
+	static FT_Face findFaceForChar(std::map< unsigned int, std::unique_ptr<FontFace> >& faceCache, const std::string& path, int size, unsigned int id, FT_Library library = nullptr);
+	static void prewarmThread();
+
 	struct Glyph
 	{
 		FontTexture* texture;
@@ -131,12 +152,21 @@ private:
 
 		Vector2i cursor;
 		Vector2i glyphSize;
+
+		float padding; // distance field glyphs : margin around glyphSize in the texture, where the distance fades out
 	};
 
+	// Signed distance field mode : glyphs are rasterized once in an atlas shared by all the sizes of the font file
+	class DistanceFieldAtlas;
+	std::shared_ptr<DistanceFieldAtlas> mDistanceField;
+	float getDistanceFieldSmoothing() const;
+
 	Glyph* mGlyphCacheArray[255]; // used to cache 255 first chars
 	std::map<unsigned int, Glyph*> mGlyphMap;
 
 	Glyph* getGlyph(unsigned int id);
+	Glyph* addGlyph(unsigned int id, const Vector2i& glyphSize, const unsigned char* pixels, const Vector2f& advance, const Vector2f& bearing);
+	float getGlyphAdvance(unsigned int id);
 
 	int mMaxGlyphHeight;
 	
@@ -146,6 +176,23 @@ private:
 
 	float getNewlineStartOffset(const std::string& text, const unsigned int& charStart, const float& xLen, const Alignment& alignment);
 
+	// Layout cache of wrapText/sizeWrappedText/getWrappedTextCursorOffset, by text and width, least recently used entries are dropped
+	struct TextLayout
+	{
+		size_t key;
+		std::string text;
+		float xLen;
+		std::string wrapped;
+		std::vector<std::pair<float, Vector2f>> sizes; // by line spacing
+	};
+
+	std::list<TextLayout> mLayoutCache;
+	std::unordered_map<size_t, std::list<TextLayout>::iterator> mLayoutIndex;
+
+	TextLayout& getTextLayout(const std::string& text, float xLen);
+	std::string layoutText(const std::string& text, float xLen);
+	void measureText(const std::string& text, size_t start, size_t end, float lineHeight, float& lineWidth, float& highestWidth);
+
 	friend TextCache;
 };
 
@@ -169,20 +216,27 @@ protected:
 
 	struct VertexList
 	{
+		VertexList() : textureIdPtr(nullptr), vertexBuffer(0) { }
+
 		std::vector<Renderer::Vertex> verts;
 		unsigned int* textureIdPtr; // this is a pointer because the texture ID can change during deinit/reinit (when launching a game)
+		unsigned int vertexBuffer; // static vertex buffer of long texts, created on first render
 	};
 
 	std::vector<VertexList> vertexLists;
 	std::vector<TextImageSubstitute> imageSubstitutes;
 	bool renderingGlow;
+	float distanceField; // edge smoothing if the glyphs are distance fields, 0 otherwise
 
 public:
 	TextCache()
 	{
 		renderingGlow = false;
+		distanceField = 0.0f;
 	}
 
+	~TextCache();
+
 	struct CacheMetrics
 	{
 		Vector2f size;
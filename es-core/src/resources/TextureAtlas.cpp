@@ -0,0 +1,175 @@
+#include "resources/TextureAtlas.h"
+
+#include "renderers/Renderer.h"
+#include "Settings.h"
+#include "Log.h"
+#include <string.h>
+
+std::vector<TextureAtlas::Page*>	TextureAtlas::sPages;
+std::mutex							TextureAtlas::sLock;
+
+bool TextureAtlas::canPack(size_t width, size_t height)
+{
+	if (width == 0 || height == 0 || width > MAX_IMAGE_SIZE || height > MAX_IMAGE_SIZE)
+		return false;
+
+	return Settings::getInstance()->getBool("TextureAtlas");
+}
+
+bool TextureAtlas::allocate(Page* page, int w, int h, Rect& rect)
+{
+	// Reuse a slot released by a previous image, if it does not waste too much space
+	for (auto it = page->freeRects.begin(); it != page->freeRects.end(); ++it)
+	{
+		if (it->w >= w && it->h >= h && it->w * it->h <= w * h * 2)
+		{
+			rect = *it;
+			page->freeRects.erase(it);
+			return true;
+		}
+	}
+
+	// Find a shelf with a close height
+	for (auto& shelf : page->shelves)
+	{
+		if (shelf.height < h || shelf.height > h + h / 4 + 4 || shelf.x + w > PAGE_SIZE)
+			continue;
+
+		rect = { shelf.x, shelf.y, w, shelf.height };
+		shelf.x += w;
+		return true;
+	}
+
+	// Open a new shelf
+	if (page->nextY + h > PAGE_SIZE)
+		return false;
+
+	Shelf shelf = { page->nextY, h, w };
+	page->shelves.push_back(shelf);
+	page->nextY += h;
+
+	rect = { 0, shelf.y, w, h };
+	return true;
+}
+
+TextureAtlas::Region TextureAtlas::add(const unsigned char* dataRGBA, size_t width, size_t height, bool linear)
+{
+	Region region;
+	if (dataRGBA == nullptr || !canPack(width, height))
+		return region;
+
+	std::unique_lock<std::mutex> lock(sLock);
+
+	const int w = (int)width + PADDING * 2;
+	const int h = (int)height + PADDING * 2;
+
+	Page* page = nullptr;
+	Rect rect;
+
+	for (auto pg : sPages)
+	{
+		if (pg->linear == linear && allocate(pg, w, h, rect))
+		{
+			page = pg;
+			break;
+		}
+	}
+
+	if (page == nullptr)
+	{
+		unsigned int texture = Renderer::createTexture(Renderer::Texture::RGBA, linear, false, PAGE_SIZE, PAGE_SIZE, nullptr);
+		if (texture == 0)
+			return region;
+
+		LOG(LogDebug) << "TextureAtlas : creating page " << sPages.size();
+
+		page = new Page();
+		page->texture = texture;
+		page->linear = linear;
+		page->used = 0;
+		page->nextY = 0;
+		sPages.push_back(page);
+
+		if (!allocate(page, w, h, rect))
+			return region;
+	}
+
+	// Copy the image with its borders extruded in the padding, so linear filtering does not bleed neighbours in
+	unsigned char* padded = new unsigned char[w * h * 4];
+
+	for (int y = 0; y < h; y++)
+	{
+		int sy = Math::min(Math::max(y - PADDING, 0), (int)height - 1);
+		const unsigned char* src = dataRGBA + sy * width * 4;
+		unsigned char* dst = padded + y * w * 4;
+
+		memcpy(dst + PADDING * 4, src, width * 4);
+
+		for (int p = 0; p < PADDING; p++)
+		{
+			memcpy(dst + p * 4, src, 4);
+			memcpy(dst + (PADDING + width + p) * 4, src + (width - 1) * 4, 4);
+		}
+	}
+
+	Renderer::updateTexture(page->texture, Renderer::Texture::RGBA, rect.x, rect.y, w, h, padded);
+	delete[] padded;
+
+	page->used++;
+
+	region.texture = page->texture;
+	region.x = rect.x;
+	region.y = rect.y;
+	region.w = rect.w;
+	region.h = rect.h;
+	region.uv = Vector4f(
+		(float)(rect.x + PADDING) / PAGE_SIZE,
+		(float)(rect.y + PADDING) / PAGE_SIZE,
+		(float)width / PAGE_SIZE,
+		(float)height / PAGE_SIZE);
+
+	return region;
+}
+
+void TextureAtlas::remove(const Region& region)
+{
+	if (region.empty())
+		return;
+
+	std::unique_lock<std::mutex> lock(sLock);
+
+	for (auto it = sPages.begin(); it != sPages.end(); ++it)
+	{
+		Page* page = *it;
+		if (page->texture != region.texture)
+			continue;
+
+		page->used--;
+
+		if (page->used <= 0)
+		{
+			// Don't keep empty pages : they would become invalid after a renderer reinit
+			Renderer::destroyTexture(page->texture);
+			delete page;
+			sPages.erase(it);
+		}
+		else
+		{
+			Rect rect = { region.x, region.y, region.w, region.h };
+			page->freeRects.push_back(rect);
+		}
+
+		return;
+	}
+}
+
+size_t TextureAtlas::getPageCount()
+{
+	std::unique_lock<std::mutex> lock(sLock);
+	return sPages.size();
+}
+
+size_t TextureAtlas::getTotalMemUsage()
+{
+	return getPageCount() * PAGE_SIZE * PAGE_SIZE * 4;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#ifndef ES_CORE_RESOURCES_TEXTURE_ATLAS_H
+#define ES_CORE_RESOURCES_TEXTURE_ATLAS_H
+
+#include "math/Vector4f.h"
+#include <mutex>
+#include <vector>
+
+//
+// Packs small static images (icons, badges, logos...) into shared texture pages.
+// Every image stored in the same page can be drawn without rebinding a texture : users
+// of the texture only have to remap their texture coordinates with the region's uv rect.
+//
+class TextureAtlas
+{
+public:
+	static const int PAGE_SIZE = 1024;
+	static const int MAX_IMAGE_SIZE = 256;
+	static const int PADDING = 1;
+
+	struct Region
+	{
+		Region() : texture(0), x(0), y(0), w(0), h(0), uv(0.0f, 0.0f, 1.0f, 1.0f) { }
+
+		bool empty() const { return texture == 0; }
+
+		unsigned int	texture;
+		int				x, y, w, h; // Slot in the page, padding included
+		Vector4f		uv;			// Normalized (x, y, w, h) of the image in the page
+	};
+
+	// Returns true if an image of this size is worth packing in an atlas page
+	static bool canPack(size_t width, size_t height);
+
+	// Uploads the image to a page that has enough room left. Returns an empty region if the image can't be packed
+	static Region add(const unsigned char* dataRGBA, size_t width, size_t height, bool linear);
+	static void remove(const Region& region);
+
+	static size_t getPageCount();
+	static size_t getTotalMemUsage();
+
+private:
+	struct Rect
+	{
+		int x, y, w, h;
+	};
+
+	struct Shelf
+	{
+		int y, height, x;
+	};
+
+	struct Page
+	{
+		unsigned int		texture;
+		bool				linear;
+		int					used;
+		int					nextY;
+		std::vector<Shelf>	shelves;
+		std::vector<Rect>	freeRects;
+	};
+
+	static bool allocate(Page* page, int w, int h, Rect& rect);
+
+	static std::vector<Page*>	sPages;
+	static std::mutex			sLock;
+};
+
+#endif // ES_CORE_RESOURCES_TEXTURE_ATLAS_H
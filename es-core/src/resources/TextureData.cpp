@@ -11,6 +11,11 @@
 #include "Settings.h"
 
 #include <algorithm>
+#include <chrono>
+#include <list>
+#include <map>
+#include <tuple>
+#include <vector>
 #include "utils/ZipFile.h"
 #include "utils/StringUtil.h"
 #include "utils/FileSystemUtil.h"
@@ -19,12 +24,19 @@
 
 #define OPTIMIZEVRAM Settings::getInstance()->getBool("OptimizeVRAM")
 
+#define MIPMAP_LEVELS	2
+#define MIPMAP_MIN_SIZE	64
+
 TextureData::TextureData(bool tile, bool linear) : mTile(tile), mLinear(linear), mTextureID(0), mDataRGBA(nullptr), mScalable(false),
 									  mWidth(0), mHeight(0), mSourceWidth(0.0f), mSourceHeight(0.0f),
 									  mPackedSize(Vector2i(0, 0)), mBaseSize(Vector2i(0, 0))
 {
 	mIsExternalDataRGBA = false;
 	mRequired = false;
+	mRasterPending = false;
+	mReloadFailed = false;
+	mMipmapped = false;
+	mLastLevel = 0;
 }
 
 TextureData::~TextureData()
@@ -41,17 +53,78 @@ void TextureData::initFromPath(const std::string& path)
 	mReloadable = true;
 }
 
-bool TextureData::initSVGFromMemory(const unsigned char* fileData, size_t length)
+// Rasterized SVGs are kept in a small LRU cache shared by every texture : the same theme icons are usually
+// rasterized at the same size for every system, and again on each theme reload
+#define SVG_CACHE_MAX_SIZE		(16 * 1024 * 1024)
+#define SVG_CACHE_MAX_ITEM_SIZE	(1024 * 1024)
+
+struct SVGRaster
 {
-	// If already initialised then don't read again
-	std::unique_lock<std::mutex> lock(mMutex);
-	if (mDataRGBA || (mTextureID != 0))
-		return true;
+	size_t		width;
+	size_t		height;
+	float		sourceWidth;
+	float		sourceHeight;
+	Vector2i	baseSize;
+	Vector2i	packedSize;
+	std::vector<unsigned char> data;
+};
+
+// Path, file modification time (an edited svg is rasterized again), source size, max size, flags
+typedef std::tuple<std::string, time_t, int, int, int, int, int> SVGRasterKey;
+typedef std::list<std::pair<SVGRasterKey, std::shared_ptr<SVGRaster>>> SVGRasterList;
+
+static std::mutex sSVGCacheLock;
+static SVGRasterList sSVGCache; // Most recently used first
+static std::map<SVGRasterKey, SVGRasterList::iterator> sSVGCacheIndex;
+static size_t sSVGCacheSize = 0;
+
+static std::shared_ptr<SVGRaster> getCachedSVGRaster(const SVGRasterKey& key)
+{
+	std::unique_lock<std::mutex> lock(sSVGCacheLock);
+
+	auto it = sSVGCacheIndex.find(key);
+	if (it == sSVGCacheIndex.cend())
+		return nullptr;
 
+	// splice keeps the iterators valid
+	sSVGCache.splice(sSVGCache.begin(), sSVGCache, it->second);
+	return it->second->second;
+}
+
+static void putCachedSVGRaster(const SVGRasterKey& key, const std::shared_ptr<SVGRaster>& raster)
+{
+	if (raster->data.size() > SVG_CACHE_MAX_ITEM_SIZE)
+		return;
+
+	std::unique_lock<std::mutex> lock(sSVGCacheLock);
+
+	// Another loader thread may have rasterized the same svg meanwhile
+	auto it = sSVGCacheIndex.find(key);
+	if (it != sSVGCacheIndex.cend())
+	{
+		sSVGCacheSize -= it->second->second->data.size();
+		sSVGCache.erase(it->second);
+		sSVGCacheIndex.erase(it);
+	}
+
+	sSVGCache.push_front(std::make_pair(key, raster));
+	sSVGCacheIndex[key] = sSVGCache.begin();
+	sSVGCacheSize += raster->data.size();
+
+	while (sSVGCacheSize > SVG_CACHE_MAX_SIZE && sSVGCache.size() > 1)
+	{
+		sSVGCacheSize -= sSVGCache.back().second->data.size();
+		sSVGCacheIndex.erase(sSVGCache.back().first);
+		sSVGCache.pop_back();
+	}
+}
+
+static std::shared_ptr<SVGRaster> rasterizeSVG(const unsigned char* fileData, size_t length, float sourceWidth, float sourceHeight, MaxSizeInfo maxSize)
+{
 	// nsvgParse excepts a modifiable, null-terminated string
 	char* copy = (char*)malloc(length + 1);
 	if (copy == NULL)
-		return false;
+		return nullptr;
 	
 	memcpy(copy, fileData, length);
 	copy[length] = '\0';
@@ -61,90 +134,151 @@ bool TextureData::initSVGFromMemory(const unsigned char* fileData, size_t length
 	if (!svgImage)
 	{
 		LOG(LogError) << "Error parsing SVG image.";
-		return false;
+		return nullptr;
 	}
 
 	if (svgImage->width == 0 || svgImage->height == 0)
-		return false;
+	{
+		nsvgDelete(svgImage);
+		return nullptr;
+	}
 
 	// We want to rasterise this texture at a specific resolution. If the source size
 	// variables are set then use them otherwise set them from the parsed file
-	if ((mSourceWidth == 0.0f) && (mSourceHeight == 0.0f))
+	if ((sourceWidth == 0.0f) && (sourceHeight == 0.0f))
 	{
-		mSourceWidth = svgImage->width;
-		mSourceHeight = svgImage->height;
+		sourceWidth = svgImage->width;
+		sourceHeight = svgImage->height;
 
-		if (!mMaxSize.empty() && mSourceWidth < mMaxSize.x() && mSourceHeight < mMaxSize.y())
+		if (!maxSize.empty() && sourceWidth < maxSize.x() && sourceHeight < maxSize.y())
 		{
-			auto sz = ImageIO::adjustPictureSize(Vector2i(mSourceWidth, mSourceHeight), Vector2i(mMaxSize.x(), mMaxSize.y()));
-			mSourceWidth = sz.x();
-			mSourceHeight = sz.y();
+			auto sz = ImageIO::adjustPictureSize(Vector2i(sourceWidth, sourceHeight), Vector2i(maxSize.x(), maxSize.y()));
+			sourceWidth = sz.x();
+			sourceHeight = sz.y();
 		}
 	}
 	else
-		mSourceWidth = (mSourceHeight * svgImage->width) / svgImage->height; // FCA : Always compute width using source aspect ratio
-
+		sourceWidth = (sourceHeight * svgImage->width) / svgImage->height; // FCA : Always compute width using source aspect ratio
 
-	mWidth = (size_t)Math::round(mSourceWidth);
-	mHeight = (size_t)Math::round(mSourceHeight);
+	size_t width = (size_t)Math::round(sourceWidth);
+	size_t height = (size_t)Math::round(sourceHeight);
 
-	if (mWidth == 0)
+	if (width == 0)
 	{
 		// auto scale width to keep aspect
-		mWidth = (size_t)Math::round(((float)mHeight / svgImage->height) * svgImage->width);
+		width = (size_t)Math::round(((float)height / svgImage->height) * svgImage->width);
 	}
-	else if (mHeight == 0)
+	else if (height == 0)
 	{
 		// auto scale height to keep aspect
-		mHeight = (size_t)Math::round(((float)mWidth / svgImage->width) * svgImage->height);
+		height = (size_t)Math::round(((float)width / svgImage->width) * svgImage->height);
 	}
 
-	mBaseSize = Vector2i(mWidth, mHeight);
+	auto raster = std::make_shared<SVGRaster>();
+	raster->baseSize = Vector2i(width, height);
+	raster->packedSize = Vector2i(0, 0);
 
-	if (OPTIMIZEVRAM && !mMaxSize.empty())
+	if (OPTIMIZEVRAM && !maxSize.empty())
 	{
-		if (mHeight < mMaxSize.y() && mWidth < mMaxSize.x()) // FCATMP
+		if (height < maxSize.y() && width < maxSize.x()) // FCATMP
 		{
-			Vector2i sz = ImageIO::adjustPictureSize(Vector2i(mWidth, mHeight), Vector2i(mMaxSize.x(), mMaxSize.y()), mMaxSize.externalZoom());
-			mHeight = sz.y();
-			mWidth = Math::round((mHeight * svgImage->width) / svgImage->height);
+			Vector2i sz = ImageIO::adjustPictureSize(Vector2i(width, height), Vector2i(maxSize.x(), maxSize.y()), maxSize.externalZoom());
+			height = sz.y();
+			width = Math::round((height * svgImage->width) / svgImage->height);
 		}
 
-		if (!mMaxSize.empty() && (mWidth > mMaxSize.x() || mHeight > mMaxSize.y()))
+		if (!maxSize.empty() && (width > maxSize.x() || height > maxSize.y()))
 		{
-			Vector2i sz = ImageIO::adjustPictureSize(Vector2i(mWidth, mHeight), Vector2i(mMaxSize.x(), mMaxSize.y()), mMaxSize.externalZoom());
-			mHeight = sz.y();
-			mWidth = Math::round((mHeight * svgImage->width) / svgImage->height);
+			Vector2i sz = ImageIO::adjustPictureSize(Vector2i(width, height), Vector2i(maxSize.x(), maxSize.y()), maxSize.externalZoom());
+			height = sz.y();
+			width = Math::round((height * svgImage->width) / svgImage->height);
 			
-			mPackedSize = Vector2i(mWidth, mHeight);
+			raster->packedSize = Vector2i(width, height);
 		}
-		else
-			mPackedSize = Vector2i(0, 0);
 	}
-	else
-		mPackedSize = Vector2i(0, 0);
 
-	if (mWidth * mHeight <= 0)
+	if (width * height <= 0)
 	{
 		LOG(LogError) << "Error parsing SVG image size.";
-		return false;
+		nsvgDelete(svgImage);
+		return nullptr;
 	}
 
-	unsigned char* dataRGBA = new unsigned char[mWidth * mHeight * 4];
+	raster->width = width;
+	raster->height = height;
+	raster->sourceWidth = sourceWidth;
+	raster->sourceHeight = sourceHeight;
+	raster->data.resize(width * height * 4);
 
-	double scale = ((float)((int)mHeight)) / svgImage->height;
-	double scaleV = ((float)((int)mWidth)) / svgImage->width;
+	double scale = ((float)((int)height)) / svgImage->height;
+	double scaleV = ((float)((int)width)) / svgImage->width;
 	if (scaleV < scale)
 		scale = scaleV;
 
 	NSVGrasterizer* rast = nsvgCreateRasterizer();
-	nsvgRasterize(rast, svgImage, 0, 0, scale, dataRGBA, (int)mWidth, (int)mHeight, (int)mWidth * 4);
+	nsvgRasterize(rast, svgImage, 0, 0, scale, raster->data.data(), (int)width, (int)height, (int)width * 4);
 	nsvgDeleteRasterizer(rast);
 	nsvgDelete(svgImage);
 
-	ImageIO::flipPixelsVert(dataRGBA, mWidth, mHeight);
+	ImageIO::flipPixelsVert(raster->data.data(), width, height);
+
+	return raster;
+}
+
+bool TextureData::initSVGFromMemory(const unsigned char* fileData, size_t length)
+{
+	float sourceWidth, sourceHeight;
+	MaxSizeInfo maxSize;
 
+	{
+		// If already initialised then don't read again, unless a new rasterization size was requested
+		std::unique_lock<std::mutex> lock(mMutex);
+		if (!mRasterPending && (mDataRGBA || (mTextureID != 0)))
+			return true;
+
+		sourceWidth = mSourceWidth;
+		sourceHeight = mSourceHeight;
+		maxSize = mMaxSize;
+	}
+
+	// Rasterization is done without holding the lock : the current texture can still be bound while it's running
+	SVGRasterKey key(mPath, mPath.empty() ? 0 : Utils::FileSystem::getFileModificationDate(mPath).getTime(), (int)sourceWidth, (int)sourceHeight, (int)maxSize.x(), (int)maxSize.y(), (OPTIMIZEVRAM ? 1 : 0) | (maxSize.externalZoom() ? 2 : 0));
+
+	std::shared_ptr<SVGRaster> raster = mPath.empty() ? nullptr : getCachedSVGRaster(key);
+	if (raster == nullptr)
+	{
+		raster = rasterizeSVG(fileData, length, sourceWidth, sourceHeight, maxSize);
+		if (raster == nullptr)
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mRasterPending = false;
+			return false;
+		}
+
+		if (!mPath.empty())
+			putCachedSVGRaster(key, raster);
+	}
+
+	unsigned char* dataRGBA = new unsigned char[raster->data.size()];
+	memcpy(dataRGBA, raster->data.data(), raster->data.size());
+
+	std::vector<LevelData> levels = filterLevels(dataRGBA, raster->width, raster->height);
+
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	if (mDataRGBA != nullptr && !mIsExternalDataRGBA)
+		delete[] mDataRGBA;
+
+	mIsExternalDataRGBA = false;
 	mDataRGBA = dataRGBA;
+	mWidth = raster->width;
+	mHeight = raster->height;
+	mSourceWidth = raster->sourceWidth;
+	mSourceHeight = raster->sourceHeight;
+	mBaseSize = raster->baseSize;
+	mPackedSize = raster->packedSize;
+	mLevelData = std::move(levels);
+	mRasterPending = false;
 
 	return true;
 }
@@ -157,7 +291,10 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 	{
 		std::unique_lock<std::mutex> lock(mMutex);
 		if (mDataRGBA || (mTextureID != 0))
+		{
+			mRasterPending = false;
 			return true;
+		}
 	}
 
 	MaxSizeInfo maxSize(Renderer::getScreenWidth(), Renderer::getScreenHeight(), false);
@@ -180,6 +317,9 @@ bool TextureData::initImageFromMemory(const unsigned char* fileData, size_t leng
 
 bool TextureData::initFromRGBA(unsigned char* dataRGBA, size_t width, size_t height, bool copyData)
 {
+	// Filtered before taking the lock, a bind of the current texture never waits for it
+	std::vector<LevelData> levels = filterLevels(dataRGBA, width, height);
+
 	// If already initialised then don't read again
 	std::unique_lock<std::mutex> lock(mMutex);
 
@@ -203,6 +343,8 @@ bool TextureData::initFromRGBA(unsigned char* dataRGBA, size_t width, size_t hei
 
 	mWidth = width;
 	mHeight = height;
+	mLevelData = std::move(levels);
+	mRasterPending = false;
 	return true;
 }
 
@@ -214,6 +356,17 @@ bool TextureData::updateFromExternalRGBA(unsigned char* dataRGBA, size_t width,
 	if (!mIsExternalDataRGBA && mDataRGBA != nullptr)
 		delete[] mDataRGBA;
 
+	// Streamed textures are updated in place and can't live in a shared page
+	if (!mAtlasRegion.empty())
+	{
+		TextureAtlas::remove(mAtlasRegion);
+		mAtlasRegion = TextureAtlas::Region();
+		mTextureID = 0;
+	}
+
+	releaseLevels();
+	mLevelData.clear();
+
 	mIsExternalDataRGBA = true;
 	mDataRGBA = dataRGBA;
 	mWidth = width;
@@ -289,41 +442,74 @@ bool TextureData::load(bool updateCache)
 		LOG(LogDebug) << "TextureData::load " << mPath;
 
 		if (mPath.substr(mPath.size() - 4, std::string::npos) == ".cbz")
-			return loadFromCbz();
-		
-		std::shared_ptr<ResourceManager>& rm = ResourceManager::getInstance();
-		const ResourceData& data = rm->getFileData(mPath);
-		// is it an SVG?
-		if (mPath.substr(mPath.size() - 4, std::string::npos) == ".svg")
+			retval = loadFromCbz();
+		else
 		{
-			mScalable = true;
-			retval = initSVGFromMemory((const unsigned char*)data.ptr.get(), data.length);
+			std::shared_ptr<ResourceManager>& rm = ResourceManager::getInstance();
+			const ResourceData& data = rm->getFileData(mPath);
+			// is it an SVG?
+			if (mPath.substr(mPath.size() - 4, std::string::npos) == ".svg")
+			{
+				mScalable = true;
+				retval = initSVGFromMemory((const unsigned char*)data.ptr.get(), data.length);
+			}
+			else
+				retval = initImageFromMemory((const unsigned char*)data.ptr.get(), data.length);
+
+			if (updateCache && retval)
+				ImageIO::updateImageCache(mPath, data.length, mBaseSize.x(), mBaseSize.y());
 		}
-		else
-			retval = initImageFromMemory((const unsigned char*)data.ptr.get(), data.length);
+	}
 
-		if (updateCache && retval)
-			ImageIO::updateImageCache(mPath, data.length, mBaseSize.x(), mBaseSize.y());
+	// A failed reload is not retried by bind on every frame
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+		mReloadFailed = !retval;
+
+		if (!retval)
+			mRasterPending = false;
 	}
 
 	return retval;
 }
 
+bool TextureData::isUploadPending()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	return mDataRGBA != nullptr && !mIsExternalDataRGBA;
+}
+
 bool TextureData::isLoaded()
 {
 	std::unique_lock<std::mutex> lock(mMutex);
-	if (mDataRGBA || (mTextureID != 0))
+	if (mDataRGBA || (mTextureID != 0) || !mLevels.empty())
 		return true;
 	return false;
 }
 
-bool TextureData::uploadAndBind()
+bool TextureData::uploadAndBind(const Vector2f& displaySize)
 {
 	// See if it's already been uploaded
 	std::unique_lock<std::mutex> lock(mMutex);
 
-	if (mTextureID != 0)
+	// A new rasterization of a scalable image is ready : it replaces the current texture
+	if (mTextureID != 0 && mDataRGBA != nullptr && !mIsExternalDataRGBA)
+		releaseTexture();
+
+	int level = selectLevel(displaySize);
+
+	if (level > 0 && mDataRGBA == nullptr)
+		Renderer::bindTexture(mLevels[level - 1].textureID);
+	else if (mTextureID != 0)
 		Renderer::bindTexture(mTextureID);
+	else if (mDataRGBA == nullptr && !mLevels.empty())
+	{
+		// The full level was released to free VRAM : draw the largest reduced level until it's reloaded
+		if (!mReloadFailed)
+			mRasterPending = true;
+
+		Renderer::bindTexture(mLevels[0].textureID);
+	}
 	else
 	{
 		// Make sure we're ready to upload
@@ -333,15 +519,42 @@ bool TextureData::uploadAndBind()
 			return false;
 		}
 
+		auto uploadStart = std::chrono::steady_clock::now();
+
+		// Small static images are packed in a shared atlas page to reduce texture switches
+		if (!mTile && !mIsExternalDataRGBA && TextureAtlas::canPack(mWidth, mHeight))
+		{
+			mAtlasRegion = TextureAtlas::add(mDataRGBA, mWidth, mHeight, mLinear);
+			mTextureID = mAtlasRegion.texture;
+		}
+
 		// Upload texture
-		mTextureID = Renderer::createTexture(Renderer::Texture::RGBA, mLinear, mTile, mWidth, mHeight, mDataRGBA);
+		if (mTextureID == 0)
+		{
+			mTextureID = Renderer::createTexture(Renderer::Texture::RGBA, mLinear, mTile, mWidth, mHeight, mDataRGBA);
+
+			if (mTextureID != 0 && !mLevelData.empty() && !mTile && !mIsExternalDataRGBA)
+				createLevels();
+			else
+				releaseLevels();
+		}
+
+		Renderer::addTextureUploadTime((int)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - uploadStart).count());
+
 		if (mTextureID == 0)
 			return false;
 
+		level = selectLevel(displaySize);
+		if (level > 0)
+			Renderer::bindTexture(mLevels[level - 1].textureID);
+		else if (!mAtlasRegion.empty() || !mLevels.empty())
+			Renderer::bindTexture(mTextureID);
+
 		if (mDataRGBA != nullptr && !mIsExternalDataRGBA)
 			delete[] mDataRGBA;
 
 		mDataRGBA = nullptr;
+		mLevelData.clear();
 	}
 
 	return true;
@@ -350,11 +563,133 @@ bool TextureData::uploadAndBind()
 void TextureData::releaseVRAM()
 {
 	std::unique_lock<std::mutex> lock(mMutex);
-	if (mTextureID != 0)
+	releaseTexture();
+}
+
+void TextureData::releaseTexture()
+{
+	if (!mAtlasRegion.empty())
+	{
+		TextureAtlas::remove(mAtlasRegion);
+		mAtlasRegion = TextureAtlas::Region();
+		mTextureID = 0;
+	}
+	else if (mTextureID != 0)
 	{
 		Renderer::destroyTexture(mTextureID);
 		mTextureID = 0;
 	}
+
+	releaseLevels();
+}
+
+int TextureData::selectLevel(const Vector2f& displaySize)
+{
+	// Smallest level that is still larger than the area it's drawn to
+	int level = 0;
+	if (displaySize.x() > 0 && displaySize.y() > 0)
+	{
+		while (level < (int)mLevels.size() && mLevels[level].width >= displaySize.x() && mLevels[level].height >= displaySize.y())
+			level++;
+	}
+
+	mLastLevel = level;
+	return level;
+}
+
+// Called by load() on the loader thread : the UI thread only uploads the result
+std::vector<TextureData::LevelData> TextureData::filterLevels(const unsigned char* dataRGBA, size_t width, size_t height)
+{
+	std::vector<LevelData> levels;
+
+	// Small images end up in an atlas page, which has no reduced levels
+	if (!mMipmapped || mTile || dataRGBA == nullptr || TextureAtlas::canPack(width, height) || !Settings::getInstance()->getBool("TextureMipmaps"))
+		return levels;
+
+	const unsigned char* src = dataRGBA;
+	size_t srcWidth = width;
+	size_t srcHeight = height;
+
+	while (levels.size() < MIPMAP_LEVELS && srcWidth / 2 >= MIPMAP_MIN_SIZE && srcHeight / 2 >= MIPMAP_MIN_SIZE)
+	{
+		LevelData level;
+		level.width = srcWidth / 2;
+		level.height = srcHeight / 2;
+		level.data.resize(level.width * level.height * 4);
+
+		// 2x2 box filter. Colors are weighted by alpha so transparent pixels don't darken the edges
+		for (size_t y = 0; y < level.height; y++)
+		{
+			const unsigned char* row0 = src + (y * 2) * srcWidth * 4;
+			const unsigned char* row1 = row0 + srcWidth * 4;
+			unsigned char* dst = level.data.data() + y * level.width * 4;
+
+			for (size_t x = 0; x < level.width; x++, row0 += 8, row1 += 8, dst += 4)
+			{
+				const unsigned int a = row0[3] + row0[7] + row1[3] + row1[7];
+
+				for (int c = 0; c < 3; c++)
+				{
+					if (a == 0)
+						dst[c] = (row0[c] + row0[c + 4] + row1[c] + row1[c + 4] + 2) / 4;
+					else
+						dst[c] = (row0[c] * row0[3] + row0[c + 4] * row0[7] + row1[c] * row1[3] + row1[c + 4] * row1[7] + a / 2) / a;
+				}
+
+				dst[3] = (a + 2) / 4;
+			}
+		}
+
+		levels.push_back(std::move(level));
+
+		src = levels.back().data.data();
+		srcWidth = levels.back().width;
+		srcHeight = levels.back().height;
+	}
+
+	return levels;
+}
+
+void TextureData::createLevels()
+{
+	releaseLevels();
+
+	for (auto& data : mLevelData)
+	{
+		unsigned int textureID = Renderer::createTexture(Renderer::Texture::RGBA, mLinear, false, data.width, data.height, data.data.data());
+		if (textureID == 0)
+			break;
+
+		Level level = { textureID, data.width, data.height };
+		mLevels.push_back(level);
+	}
+}
+
+void TextureData::releaseLevels()
+{
+	for (auto& level : mLevels)
+		Renderer::destroyTexture(level.textureID);
+
+	mLevels.clear();
+}
+
+size_t TextureData::releaseFullLevel()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	if (mLastLevel == 0 || mLevels.empty() || mTextureID == 0 || !mAtlasRegion.empty() || mDataRGBA != nullptr)
+		return 0;
+
+	Renderer::destroyTexture(mTextureID);
+	mTextureID = 0;
+
+	return mWidth * mHeight * 4;
+}
+
+Vector4f TextureData::getAtlasRect()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	return mAtlasRegion.uv;
 }
 
 void TextureData::releaseRAM()
@@ -365,6 +700,7 @@ void TextureData::releaseRAM()
 		delete[] mDataRGBA;
 
 	mDataRGBA = 0;
+	mLevelData.clear();
 }
 
 size_t TextureData::width()
@@ -403,7 +739,7 @@ void TextureData::setTemporarySize(float width, float height)
 	mSourceHeight = height;
 }
 
-void TextureData::setSourceSize(float width, float height)
+bool TextureData::setSourceSize(float width, float height, bool async)
 {
 	if (mScalable)
 	{
@@ -411,6 +747,16 @@ void TextureData::setSourceSize(float width, float height)
 		{
 			LOG(LogDebug) << "Requested scalable image size too small. Reloading image from (" << mSourceWidth << ", " << mSourceHeight << ") to (" << width << ", " << height << ")";
 
+			if (async && isLoaded())
+			{
+				// Keep the current texture until the background loader has rasterized the new size
+				std::unique_lock<std::mutex> lock(mMutex);
+				mSourceWidth = width;
+				mSourceHeight = height;
+				mRasterPending = true;
+				return true;
+			}
+
 			mSourceWidth = width;
 			mSourceHeight = height;
 			releaseVRAM();
@@ -418,14 +764,28 @@ void TextureData::setSourceSize(float width, float height)
 			load();
 		}
 	}
+
+	return false;
+}
+
+bool TextureData::isRasterPending()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	return mRasterPending;
 }
 
 size_t TextureData::getVRAMUsage()
 {
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	size_t usage = 0;
 	if ((mTextureID != 0) || (mDataRGBA != nullptr))
-		return mWidth * mHeight * 4;
-	else
-		return 0;
+		usage = mWidth * mHeight * 4;
+
+	for (auto& level : mLevels)
+		usage += level.width * level.height * 4;
+
+	return usage;
 }
 
 void TextureData::setMaxSize(MaxSizeInfo maxSize)
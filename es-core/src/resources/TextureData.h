@@ -4,7 +4,9 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 #include "ImageIO.h"
+#include "resources/TextureAtlas.h"
 
 class TextureResource;
 
@@ -28,9 +30,12 @@ public:
 
 	bool isLoaded();
 
+	// True when pixels are waiting to be uploaded to VRAM on next bind
+	bool isUploadPending();
+
 	// Upload the texture to VRAM if necessary and bind. Returns true if bound ok or
-	// false if either not loaded
-	bool uploadAndBind();
+	// false if either not loaded. If displaySize is set, the smallest level that still covers it is bound
+	bool uploadAndBind(const Vector2f& displaySize = Vector2f(0.0f, 0.0f));
 
 	// Release the texture from VRAM
 	void releaseVRAM();
@@ -38,6 +43,9 @@ public:
 	// Release the texture from conventional RAM
 	void releaseRAM();
 
+	// Release the full resolution texture if the last draws only used a reduced level. Returns the amount of VRAM freed
+	size_t releaseFullLevel();
+
 	// Get the amount of VRAM currenty used by this texture
 	size_t getVRAMUsage();
 
@@ -45,7 +53,14 @@ public:
 	size_t height();
 	float sourceWidth();
 	float sourceHeight();
-	void setSourceSize(float width, float height);
+	// Returns true if the new size has to be rasterized in the background : the current texture stays usable until then
+	bool setSourceSize(float width, float height, bool async = false);
+	// True when new pixels were requested (new rasterization or released full level) while the current texture stays bound
+	bool isRasterPending();
+
+	// Keeps reduced resolution levels (1/2, 1/4) of the image, for images drawn at very different sizes
+	void setMipmapped(bool value) { mMipmapped = value; }
+	bool isMipmapped() { return mMipmapped; }
 
 	bool tiled() { return mTile; }
 
@@ -62,11 +77,36 @@ public:
 
 	bool updateFromExternalRGBA(unsigned char* dataRGBA, size_t width, size_t height);
 
+	// Normalized area of the image in the bound GL texture : (0, 0, 1, 1) unless it was packed in an atlas page
+	Vector4f getAtlasRect();
+
 	bool isRequired() { return mRequired; };
 	void setRequired(bool value) { mRequired = value; };
 
 private:
+	struct Level
+	{
+		unsigned int	textureID;
+		size_t			width;
+		size_t			height;
+	};
+
+	struct LevelData
+	{
+		std::vector<unsigned char>	data;
+		size_t						width;
+		size_t						height;
+	};
+
+	void releaseTexture();
+	int  selectLevel(const Vector2f& displaySize);
+	std::vector<LevelData> filterLevels(const unsigned char* dataRGBA, size_t width, size_t height);
+	void createLevels();
+	void releaseLevels();
+
 	bool			mRequired;
+	bool			mRasterPending;
+	bool			mReloadFailed; // the reduced levels are kept instead of asking for the full one again
 
 	std::mutex		mMutex;
 	bool			mTile;
@@ -86,6 +126,13 @@ private:
 	Vector2i		mBaseSize;
 
 	bool			mIsExternalDataRGBA;
+
+	TextureAtlas::Region mAtlasRegion;
+
+	bool				mMipmapped;
+	std::vector<Level>	mLevels;	// Reduced levels, halved each time
+	std::vector<LevelData>	mLevelData;	// Their pixels, filtered by load() and uploaded with the full level
+	int					mLastLevel;	// Level bound by the last draw : 0 is full resolution
 };
 
 #endif // ES_CORE_RESOURCES_TEXTURE_DATA_H
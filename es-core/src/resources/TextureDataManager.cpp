@@ -2,6 +2,8 @@
 
 #include "resources/TextureData.h"
 #include "resources/TextureResource.h"
+#include "renderers/Renderer.h"
+#include "GuiComponent.h"
 #include "Settings.h"
 #include "Log.h"
 #include <algorithm>
@@ -122,14 +124,34 @@ std::shared_ptr<TextureData> TextureDataManager::get(const TextureResource* key,
 	return tex;
 }
 
-bool TextureDataManager::bind(const TextureResource* key)
+bool TextureDataManager::bind(const TextureResource* key, Vector4f* atlasRect, const Vector2f* displaySize)
 {
 	std::shared_ptr<TextureData> tex = get(key);
 	bool bound = false;
-	if (tex != nullptr)
-		bound = tex->uploadAndBind();
+
+	// Over the frame's upload budget, pending textures are displayed as not loaded yet and uploaded on the next frames
+	if (tex != nullptr && (!tex->isUploadPending() || Renderer::isTextureUploadAllowed()))
+	{
+		bound = tex->uploadAndBind(displaySize == nullptr ? Vector2f(0.0f, 0.0f) : *displaySize);
+
+		// A reduced level is bound while the full one is reloaded
+		if (bound && tex->isRasterPending())
+			mLoader->load(tex);
+	}
+
+	// Retry on the next frame, even if nothing else changes : the bitmap cache being drawn would keep the missing image otherwise
+	if (!bound && tex != nullptr && tex->isUploadPending())
+		GuiComponent::invalidateBitmapCaches();
+
 	if (!bound)
+	{
 		mBlank->uploadAndBind();
+		tex = mBlank;
+	}
+
+	if (atlasRect != nullptr)
+		*atlasRect = tex->getAtlasRect();
+
 	return bound;
 }
 
@@ -194,6 +216,21 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 		LOG(LogDebug) << "Cleanup VRAM\tCurrent VRAM : " << std::to_string(size / 1024.0 / 1024.0).c_str() << " MB";
 
 		std::unique_lock<std::mutex> lock(mMutex);
+
+		// Start with full resolution levels of images that are drawn small, even visible ones : their reduced levels stay in VRAM
+		for (auto it = mTextures.crbegin(); it != mTextures.crend() && size >= max_texture; ++it)
+		{
+			if ((*it) == tex)
+				continue;
+
+			size_t released = (*it)->releaseFullLevel();
+			if (released > 0)
+			{
+				LOG(LogDebug) << "Cleanup VRAM\tReleased full level : " << (*it)->getPath().c_str();
+				size -= std::min(size, released);
+			}
+		}
+
 		for (auto it = mTextures.crbegin(); it != mTextures.crend(); ++it)
 		{
 			if (size < max_texture)
@@ -243,6 +280,39 @@ void TextureDataManager::load(std::shared_ptr<TextureData> tex, bool block)
 	}
 }
 
+void TextureDataManager::prefetch(const TextureResource* key)
+{
+	if (mLoader == nullptr)
+		return;
+
+	std::shared_ptr<TextureData> tex;
+
+	{
+		std::unique_lock<std::mutex> lock(mMutex);
+
+		auto it = mTextureLookup.find(key);
+		if (it == mTextureLookup.cend())
+			return;
+
+		tex = *(*it).second;
+	}
+
+	if (tex->isLoaded())
+		return;
+
+	// Unlike load, never release anything : textures in use are worth more than a guess
+	size_t max_texture = (size_t)Settings::getInstance()->getInt("MaxVRAM") * 1024 * 1024;
+	if (TextureResource::getTotalMemUsage() >= max_texture)
+		return;
+
+	mLoader->load(tex, true);
+}
+
+void TextureDataManager::rasterizeAsync(std::shared_ptr<TextureData> tex)
+{
+	mLoader->load(tex);
+}
+
 TextureLoader::TextureLoader(TextureDataManager* mgr) : mManager(mgr), mExit(false)
 {
 	int num_threads = std::thread::hardware_concurrency() / 2;
@@ -286,19 +356,23 @@ void TextureLoader::threadProc()
 
 			lock.unlock();
 
-			if (textureData && !textureData->isLoaded())
+			if (textureData && (!textureData->isLoaded() || textureData->isRasterPending()))
 			{
 				//LOG(LogDebug) << "TextureLoader::Thread\tLoading " << textureData->getPath().c_str();
 				std::this_thread::yield();
 
 				textureData->load(true);
-				//mManager->onTextureLoaded(textureData);				
+				//mManager->onTextureLoaded(textureData);
 
-				lock.lock();
-				mProcessingTextureDataQ.remove(textureData);			
-				lock.unlock();
+				// The texture can be displayed now
+				GuiComponent::invalidateBitmapCaches();				
 			}
 
+			// Loaded meanwhile or not : it can be queued again for a new rasterization
+			lock.lock();
+			mProcessingTextureDataQ.remove(textureData);
+			lock.unlock();
+
 			std::this_thread::yield();
 		}		
 	}
@@ -306,7 +380,7 @@ void TextureLoader::threadProc()
 
 bool TextureLoader::paused = false;
 
-void TextureLoader::load(std::shared_ptr<TextureData> textureData)
+void TextureLoader::load(std::shared_ptr<TextureData> textureData, bool lowPriority)
 {
 //	if (paused)
 	//	return;
@@ -314,7 +388,7 @@ void TextureLoader::load(std::shared_ptr<TextureData> textureData)
 	std::unique_lock<std::mutex> lock(mLoaderLock);
 
 	// Make sure it's not already loaded
-	if (textureData->isLoaded())
+	if (textureData->isLoaded() && !textureData->isRasterPending())
 		return;
 
 	// If is is currently loading, don't add again
@@ -324,10 +398,19 @@ void TextureLoader::load(std::shared_ptr<TextureData> textureData)
 	// Remove it from the queue if it is already there
 	auto tx = std::find(mTextureDataQ.cbegin(), mTextureDataQ.cend(), textureData);
 	if (tx != mTextureDataQ.cend())
+	{
+		if (lowPriority)
+			return;
+
 		mTextureDataQ.erase(tx);
+	}
 
 	// Put it on the start of the queue as we want the newly requested textures to load first
-	mTextureDataQ.push_front(textureData);
+	if (lowPriority)
+		mTextureDataQ.push_back(textureData);
+	else
+		mTextureDataQ.push_front(textureData);
+
 	mEvent.notify_one();
 }
 
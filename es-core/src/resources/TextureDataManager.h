@@ -11,6 +11,8 @@
 #include <vector>
 
 class TextureDataManager;
+class Vector2f;
+class Vector4f;
 class TextureData;
 class TextureResource;
 
@@ -20,7 +22,8 @@ public:
 	TextureLoader(TextureDataManager* mgr);
 	~TextureLoader();
 
-	void load(std::shared_ptr<TextureData> textureData);
+	// Low priority textures are queued behind all the others, and don't move when they are queued again
+	void load(std::shared_ptr<TextureData> textureData, bool lowPriority = false);
 	bool remove(std::shared_ptr<TextureData> textureData);
 	void clearQueue();
 
@@ -79,7 +82,10 @@ public:
 
 	void cancelAsync(const TextureResource* key);
 	std::shared_ptr<TextureData> get(const TextureResource* key, TextureLoadMode enableLoading = TextureLoadMode::ENABLED);
-	bool bind(const TextureResource* key);
+	bool bind(const TextureResource* key, Vector4f* atlasRect = nullptr, const Vector2f* displaySize = nullptr);
+
+	// Queues a new rasterization of a scalable texture. The current texture data stays bound until it's done
+	void rasterizeAsync(std::shared_ptr<TextureData> tex);
 
 	// Get the total size of all textures managed by this object, loaded and unloaded in bytes
 	size_t	getTotalSize();
@@ -90,6 +96,8 @@ public:
 	size_t  getQueueSize();
 	// Load a texture, freeing resources as necessary to make space
 	void load(std::shared_ptr<TextureData> tex, bool block = false);
+	// Queue a texture that may be needed soon with a low priority. Nothing is released to make room for it
+	void prefetch(const TextureResource* key);
 
 	void clearQueue();
 
@@ -1,6 +1,7 @@
 #include "resources/TextureResource.h"
 
 #include "utils/FileSystemUtil.h"
+#include "utils/StringUtil.h"
 #include "resources/TextureData.h"
 #include <cstring>
 #include "Settings.h"
@@ -11,7 +12,7 @@ TextureDataManager		TextureResource::sTextureDataManager;
 std::map< TextureResource::TextureKeyType, std::weak_ptr<TextureResource> > TextureResource::sTextureMap;
 std::set<TextureResource*> 	TextureResource::sAllTextures;
 
-TextureResource::TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo* maxSize) : mTextureData(nullptr), mForceLoad(false)
+TextureResource::TextureResource(const std::string& path, bool tile, bool linear, bool dynamic, bool allowAsync, MaxSizeInfo* maxSize) : mTextureData(nullptr), mForceLoad(false), mAtlasRect(0.0f, 0.0f, 1.0f, 1.0f)
 {
 	// Create a texture data object for this texture
 	if (!path.empty())
@@ -34,7 +35,10 @@ TextureResource::TextureResource(const std::string& path, bool tile, bool linear
 
 			unsigned int width, height;
 
-			if (allowAsync && Settings::getInstance()->getBool("AsyncImages") && ImageIO::loadImageSize(fullpath.c_str(), &width, &height))
+			// Scalable images need their target size before being rasterized : they can't use the temporary size
+			bool scalable = Utils::String::toLower(Utils::FileSystem::getExtension(fullpath)) == ".svg";
+
+			if (allowAsync && !scalable && Settings::getInstance()->getBool("AsyncImages") && ImageIO::loadImageSize(fullpath.c_str(), &width, &height))
 			{
 				data->setTemporarySize(width, height);
 				async = true;
@@ -172,15 +176,49 @@ void TextureResource::setRequired(bool value) const
 		data->setRequired(value);	
 }
 
+void TextureResource::prefetch() const
+{
+	if (mTextureData == nullptr)
+		sTextureDataManager.prefetch(this);
+}
+
 bool TextureResource::bind()
+{
+	return bind(Vector2f(0.0f, 0.0f));
+}
+
+bool TextureResource::bind(const Vector2f& displaySize)
 {
 	if (mTextureData != nullptr)
 	{
-		mTextureData->uploadAndBind();
+		mTextureData->uploadAndBind(displaySize);
+		mAtlasRect = mTextureData->getAtlasRect();
 		return true;
 	}
 
-	return sTextureDataManager.bind(this);	
+	return sTextureDataManager.bind(this, &mAtlasRect, &displaySize);
+}
+
+void TextureResource::setMipmapped(bool value)
+{
+	std::shared_ptr<TextureData> data = mTextureData;
+	if (data == nullptr)
+		data = sTextureDataManager.get(this, TextureDataManager::TextureLoadMode::DISABLED);
+
+	if (data != nullptr)
+		data->setMipmapped(value);
+}
+
+void TextureResource::mapTextureCoords(Renderer::Vertex* vertices, int count) const
+{
+	if (!isAtlased())
+		return;
+
+	for (int i = 0; i < count; i++)
+	{
+		vertices[i].tex[0] = mAtlasRect.x() + vertices[i].tex[0] * mAtlasRect.z();
+		vertices[i].tex[1] = mAtlasRect.y() + vertices[i].tex[1] * mAtlasRect.w();
+	}
 }
 
 void TextureResource::cancelAsync(std::shared_ptr<TextureResource> texture)
@@ -286,7 +324,11 @@ void TextureResource::rasterizeAt(size_t width, size_t height)
 	// mSourceSize = Vector2f((float)width, (float)height);
 	if (data != nullptr)
 	{
-		data->setSourceSize((float)width, (float)height);
+		if (data->setSourceSize((float)width, (float)height, Settings::getInstance()->getBool("AsyncImages")))
+		{
+			sTextureDataManager.rasterizeAsync(data);
+			return;
+		}
 
 		if (mForceLoad || (mTextureData != nullptr))
 			if (!data->isLoaded())
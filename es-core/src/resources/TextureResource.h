@@ -4,6 +4,8 @@
 
 #include "math/Vector2i.h"
 #include "math/Vector2f.h"
+#include "math/Vector4f.h"
+#include "renderers/Renderer.h"
 #include "resources/ResourceManager.h"
 #include "resources/TextureDataManager.h"
 #include "resources/TextureData.h"
@@ -35,9 +37,20 @@ public:
 	bool isTiled() const;
 	void prioritize() const;
 	void setRequired(bool value) const;
+	// Loads the texture in the background, after the ones that are displayed
+	void prefetch() const;
 
 	const Vector2i getSize() const;
 	bool bind();
+	// Binds the smallest resolution level that covers displaySize (in screen pixels), for mipmapped textures
+	bool bind(const Vector2f& displaySize);
+
+	void setMipmapped(bool value);
+
+	// Small textures can be packed in a shared atlas page : after bind(), texture coordinates must be remapped to the image's area
+	bool isAtlased() const { return mAtlasRect != Vector4f(0.0f, 0.0f, 1.0f, 1.0f); }
+	const Vector4f& getAtlasRect() const { return mAtlasRect; }
+	void mapTextureCoords(Renderer::Vertex* vertices, int count) const;
 
 	static size_t getTotalMemUsage(bool includeQueueSize = true); // returns an approximation of total VRAM used by textures (in bytes)
 	static size_t getTotalTextureSize(); // returns the number of bytes that would be used if all textures were in memory
@@ -60,6 +73,7 @@ private:
 	Vector2i					mSize;
 	Vector2f					mSourceSize;
 	bool							mForceLoad;
+	Vector4f					mAtlasRect;
 
 	typedef std::tuple<std::string, bool, bool> TextureKeyType;
 	static std::map< TextureKeyType, std::weak_ptr<TextureResource> > sTextureMap; // map of textures, used to prevent duplicate textures
@@ -0,0 +1,56 @@
+#include "utils/ProviderCache.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace Utils
+{
+	namespace ProviderCache
+	{
+		struct CacheEntry
+		{
+			std::chrono::steady_clock::time_point time;
+			std::vector<std::string> values;
+		};
+
+		static std::map<std::string, CacheEntry> cacheEntries;
+		static std::mutex cacheLock;
+
+		std::vector<std::string> get(const std::string& key, int ttlSeconds, const Provider& provider)
+		{
+			auto now = std::chrono::steady_clock::now();
+
+			{
+				std::unique_lock<std::mutex> lock(cacheLock);
+
+				auto it = cacheEntries.find(key);
+				if (it != cacheEntries.cend() && now - it->second.time < std::chrono::seconds(ttlSeconds))
+					return it->second.values;
+			}
+
+			// The provider runs unlocked : it can be long, and can use the cache for other keys
+			CacheEntry entry;
+			entry.values = provider();
+			entry.time = now;
+
+			std::unique_lock<std::mutex> lock(cacheLock);
+			cacheEntries[key] = entry;
+			return entry.values;
+
+		} // get
+
+		void invalidate(const std::string& key)
+		{
+			std::unique_lock<std::mutex> lock(cacheLock);
+
+			if (key.empty())
+				cacheEntries.clear();
+			else
+				cacheEntries.erase(key);
+
+		} // invalidate
+
+	} // ProviderCache::
+
+} // Utils::
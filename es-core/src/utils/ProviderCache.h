@@ -0,0 +1,26 @@
+#pragma once
+#ifndef ES_CORE_UTILS_PROVIDER_CACHE_H
+#define ES_CORE_UTILS_PROVIDER_CACHE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Utils
+{
+	// Results of expensive providers (scripts, directory scans), kept for a while so menus don't run them each time they open
+	namespace ProviderCache
+	{
+		typedef std::function<std::vector<std::string>()> Provider;
+
+		// Returns the values cached for key if they're younger than ttlSeconds, runs the provider otherwise
+		std::vector<std::string> get(const std::string& key, int ttlSeconds, const Provider& provider);
+
+		// Forgets the values of key, or all of them when key is empty
+		void invalidate(const std::string& key = "");
+
+	} // ProviderCache::
+
+} // Utils::
+
+#endif // ES_CORE_UTILS_PROVIDER_CACHE_H